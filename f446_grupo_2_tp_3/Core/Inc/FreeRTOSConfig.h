@@ -50,10 +50,18 @@
 /* Ensure definitions are only used by the compiler, and not by the assembler. */
 #if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
   #include <stdint.h>
+  #include <stddef.h>
   extern uint32_t SystemCoreClock;
 /* USER CODE BEGIN 0 */
   extern void configureTimerForRunTimeStats(void);
   extern unsigned long getRunTimeCounterValue(void);
+  extern uint8_t heap_trace_on_malloc(void * ptr, size_t size, const void * site);
+  extern void heap_trace_on_free(void * ptr, size_t size, const void * site, uint8_t tag);
+  #include "trace_rec.h"
+  #include "app.h"
+  extern void low_power_pre_sleep(uint32_t * idle_ticks);
+  extern void low_power_post_sleep(uint32_t expected_ticks);
+  extern void vtime_skip(uint32_t expected_ticks);
 /* USER CODE END 0 */
 #endif
 #define configENABLE_FPU                         0
@@ -149,6 +157,70 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+
+/* Telemetria de heap_4 (app/src/heap_trace.c): cuenta, sitio de llamada y
+   anillo de eventos de cada pvPortMalloc/vPortFree. */
+#define configAPP_HEAP_TRACE                     1
+
+/* Arranque estatico (APP_CONFIG_STATIC_ALLOCATION, app.h): en el heap solo
+   quedan Task1 y Task2 de CubeMX, 2 x (512 B de stack + TCB + encabezados)
+   ~ 1.3 KB. El resto de configTOTAL_HEAP_SIZE vuelve a la RAM libre; app_init
+   informa el heap que sobra al arrancar. */
+#if (1 == APP_CONFIG_STATIC_ALLOCATION)
+#undef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE                    ((size_t)2048)
+#endif
+
+/* Asignador del heap: 0 = heap_4.c (first-fit), 1 = heap_tlsf.c (TLSF, O(1)). */
+#define configAPP_HEAP_TLSF                      0
+
+/* Registro de cambios de contexto, colas, notificaciones e IRQ con marca DWT
+   (app/src/trace_rec.c). El volcado es Chrome trace JSON por el logger. */
+#define configAPP_KERNEL_TRACE                   0
+
+/* Idle tickless: SysTick se reprograma para dormir en WFI hasta el proximo
+   evento; app/src/low_power.c frena TIM1 (tick de la HAL) y mide el sueno. */
+#define configAPP_TICKLESS_IDLE                  1
+
+/* Tiempo virtual para escenarios de prueba: con todas las tareas bloqueadas el
+   idle adelanta los ticks en vez de esperar (app/src/vtime.c). Reemplaza al
+   idle tickless; solo para builds de TESTING, los LED no se llegan a ver. */
+#define configAPP_VIRTUAL_TIME                   0
+
+#if (1 == configAPP_HEAP_TRACE)
+/* heapTAG_SET/heapTAG_GET los define cada heap (heap_4.c, heap_tlsf.c): guardan
+   en la cabecera del bloque el sitio que lo pidio, para descontarlo al liberar. */
+#define traceMALLOC(pvAddress, uiSize)           heapTAG_SET((pvAddress), heap_trace_on_malloc((pvAddress), (uiSize), __builtin_return_address(0)))
+#define traceFREE(pvAddress, uiSize)             heap_trace_on_free((pvAddress), (uiSize), __builtin_return_address(0), heapTAG_GET(pvAddress))
+#endif
+
+#if (1 == configAPP_VIRTUAL_TIME)
+#define configUSE_TICKLESS_IDLE                  1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#define portSUPPRESS_TICKS_AND_SLEEP(x)          vtime_skip(x)
+#elif (1 == configAPP_TICKLESS_IDLE)
+#define configUSE_TICKLESS_IDLE                  1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#define configPRE_SLEEP_PROCESSING(x)            low_power_pre_sleep(&(x))
+#define configPOST_SLEEP_PROCESSING(x)           low_power_post_sleep(x)
+#endif
+
+#if (1 == configAPP_KERNEL_TRACE)
+#define traceTASK_SWITCHED_IN()                  trace_rec_switch_in(pxCurrentTCB)
+#define traceTASK_SWITCHED_OUT()                 trace_rec_switch_out(pxCurrentTCB)
+#define traceQUEUE_SEND(pxQueue)                 trace_rec_kernel(TRACE_REC_EV_QUEUE_SEND, (pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)        trace_rec_kernel(TRACE_REC_EV_QUEUE_SEND, (pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue)              trace_rec_kernel(TRACE_REC_EV_QUEUE_RECV, (pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)     trace_rec_kernel(TRACE_REC_EV_QUEUE_RECV, (pxQueue))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)     trace_rec_kernel(TRACE_REC_EV_BLOCK_SEND, (pxQueue))
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)  trace_rec_kernel(TRACE_REC_EV_BLOCK_RECV, (pxQueue))
+#define traceTASK_NOTIFY_TAKE_BLOCK()            trace_rec_kernel(TRACE_REC_EV_BLOCK_NOTIFY, NULL)
+#define traceTASK_NOTIFY()                       trace_rec_kernel(TRACE_REC_EV_NOTIFY, pxTCB)
+#define traceTASK_NOTIFY_FROM_ISR()              trace_rec_kernel(TRACE_REC_EV_NOTIFY, pxTCB)
+#define traceTASK_NOTIFY_GIVE_FROM_ISR()         trace_rec_kernel(TRACE_REC_EV_NOTIFY, pxTCB)
+#define traceTASK_DELAY()                        trace_rec_kernel(TRACE_REC_EV_DELAY, NULL)
+#define traceTASK_DELAY_UNTIL(xTimeToWake)       trace_rec_kernel(TRACE_REC_EV_DELAY, NULL)
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -24,7 +24,7 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+#include "cpu_load.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -62,14 +62,18 @@ void vApplicationIdleHook(void);
 
 /* USER CODE BEGIN 1 */
 /* Functions needed when configGENERATE_RUN_TIME_STATS is on */
+/* Base de tiempo de los run-time stats: CYCCNT, sin reiniciarlo (lo usan
+   trace_rec y las mediciones). Un contador de 32 bits a SystemCoreClock da
+   vuelta en ~23 s: los consumidores trabajan con diferencias entre muestras. */
 __weak void configureTimerForRunTimeStats(void)
 {
-
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 }
 
 __weak unsigned long getRunTimeCounterValue(void)
 {
-return 0;
+  return DWT->CYCCNT;
 }
 /* USER CODE END 1 */
 
@@ -85,6 +89,9 @@ __weak void vApplicationIdleHook( void )
    important that vApplicationIdleHook() is permitted to return to its calling
    function, because it is the responsibility of the idle task to clean up
    memory allocated by the kernel to any task that has since been deleted. */
+#if 1 == CPU_LOAD_CONFIG_ENABLE
+  cpu_load_on_idle();
+#endif
 }
 /* USER CODE END 2 */
 
@@ -28,6 +28,8 @@
 
 /* Application includes. */
 #include "app.h"
+#include "work_queue.h"
+#include "stress_test.h"
 
 /* USER CODE END Includes */
 
@@ -340,11 +342,9 @@ static void MX_GPIO_Init(void)
 void Task1_App(void const * argument)
 {
   /* USER CODE BEGIN 5 */
-  /* Infinite loop */
-  for(;;)
-  {
-    osDelay(1);
-  }
+  /* Trabajador de la cola de trabajo diferido (app/src/work_queue.c):
+     bloquea hasta que haya trabajos, no despierta al CPU por si mismo. */
+  work_worker_run();
   /* USER CODE END 5 */
 }
 
@@ -358,11 +358,8 @@ void Task1_App(void const * argument)
 void Task2_App(void const * argument)
 {
   /* USER CODE BEGIN Task2_App */
-  /* Infinite loop */
-  for(;;)
-  {
-    osDelay(1);
-  }
+  /* Segundo trabajador de la cola de trabajo diferido: ver Task1_App. */
+  work_worker_run();
   /* USER CODE END Task2_App */
 }
 
@@ -384,7 +381,12 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+#if 1 == STRESS_TEST_CONFIG_ENABLE
+  if (htim->Instance == TIM1)
+  {
+    stress_test_on_tick_isr();
+  }
+#endif
   /* USER CODE END Callback 1 */
 }
 
@@ -22,6 +22,9 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "cmsis_os.h"
+#include "trace_rec.h"
+#include "uart_io.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -179,14 +182,43 @@ void TIM1_UP_TIM10_IRQHandler(void)
 void EXTI15_10_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI15_10_IRQn 0 */
-
+#if (1 == configAPP_KERNEL_TRACE)
+  trace_rec_isr_enter(EXTI15_10_IRQn);
+#endif
   /* USER CODE END EXTI15_10_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(B1_Pin);
   /* USER CODE BEGIN EXTI15_10_IRQn 1 */
-
+#if (1 == configAPP_KERNEL_TRACE)
+  trace_rec_isr_exit(EXTI15_10_IRQn);
+#endif
   /* USER CODE END EXTI15_10_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
+#if 1 == UART_IO_CONFIG_ENABLE
+/**
+  * @brief This function handles DMA1 stream5 global interrupt (USART2_RX).
+  */
+void DMA1_Stream5_IRQHandler(void)
+{
+  uart_io_dma_rx_irq();
+}
+
+/**
+  * @brief This function handles DMA1 stream6 global interrupt (USART2_TX).
+  */
+void DMA1_Stream6_IRQHandler(void)
+{
+  uart_io_dma_tx_irq();
+}
+
+/**
+  * @brief This function handles USART2 global interrupt.
+  */
+void USART2_IRQHandler(void)
+{
+  uart_io_irq();
+}
+#endif
 
 /* USER CODE END 1 */
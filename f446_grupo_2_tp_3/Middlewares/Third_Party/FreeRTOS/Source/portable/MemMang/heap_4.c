@@ -45,6 +45,9 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* Reemplazado por heap_tlsf.c cuando configAPP_HEAP_TLSF == 1. */
+#if !defined( configAPP_HEAP_TLSF ) || ( configAPP_HEAP_TLSF == 0 )
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
 	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
@@ -72,6 +75,19 @@ typedef struct A_BLOCK_LINK
 	size_t xBlockSize;						/*<< The size of the free block. */
 } BlockLink_t;
 
+/* Con configAPP_HEAP_TRACE, un bloque asignado guarda en pxNextFreeBlock (que no
+se usa mientras esta asignado) la marca de heap_trace.c con el sitio que lo
+pidio; 0 es sin marca. Al liberarlo la lista de libres la pisa. */
+#if defined( configAPP_HEAP_TRACE ) && ( configAPP_HEAP_TRACE == 1 )
+	#define heapTAG_MAX						( ( size_t ) 0xFF )
+	#define heapBLOCK_OF( pv )				( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pv ) ) - xHeapStructSize ) )
+	#define heapTAG_SET( pv, ucTag )		do { uint8_t ucT = ( ucTag ); if( ( pv ) != NULL ) { heapBLOCK_OF( pv )->pxNextFreeBlock = ( BlockLink_t * ) ( size_t ) ucT; } } while( 0 )
+	#define heapTAG_GET( pv )				( ( uint8_t ) ( size_t ) heapBLOCK_OF( pv )->pxNextFreeBlock )
+	#define heapBLOCK_UNLINKED( pxLink )	( ( size_t ) ( pxLink )->pxNextFreeBlock <= heapTAG_MAX )
+#else
+	#define heapBLOCK_UNLINKED( pxLink )	( ( pxLink )->pxNextFreeBlock == NULL )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -279,11 +295,11 @@ BlockLink_t *pxLink;
 
 		/* Check the block is actually allocated. */
 		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
-		configASSERT( pxLink->pxNextFreeBlock == NULL );
+		configASSERT( heapBLOCK_UNLINKED( pxLink ) );
 
 		if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
 		{
-			if( pxLink->pxNextFreeBlock == NULL )
+			if( heapBLOCK_UNLINKED( pxLink ) )
 			{
 				/* The block is being returned to the heap - it is no longer
 				allocated. */
@@ -490,3 +506,4 @@ size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY use
 	taskEXIT_CRITICAL();
 }
 
+#endif /* configAPP_HEAP_TLSF */
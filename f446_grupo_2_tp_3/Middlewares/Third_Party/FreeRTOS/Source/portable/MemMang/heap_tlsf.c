@@ -0,0 +1,476 @@
+/*
+ * heap_tlsf.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/*
+ * Alternativa a heap_4.c con un asignador TLSF (Two-Level Segregated Fit):
+ * pvPortMalloc() y vPortFree() son O(1) sin importar la fragmentacion, porque
+ * la busqueda del bloque libre se resuelve con dos mapas de bits (CLZ/CTZ) en
+ * lugar de recorrer la lista de bloques como hace heap_4 (first-fit).
+ *
+ * Se selecciona con configAPP_HEAP_TLSF = 1 en FreeRTOSConfig.h (heap_4.c queda
+ * fuera de la compilacion). Usa el mismo arreglo ucHeap[configTOTAL_HEAP_SIZE] y
+ * los mismos hooks traceMALLOC/traceFREE que heap_4.
+ *
+ * Cada bloque lleva una cabecera de 8 bytes (bloque fisico anterior + tamano),
+ * igual que heap_4; los bloques libres guardan ademas sus enlaces de lista en el
+ * payload. Los tamanos son multiplos de portBYTE_ALIGNMENT (8).
+ */
+#include <stdlib.h>
+#include <stddef.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if defined( configAPP_HEAP_TLSF ) && ( configAPP_HEAP_TLSF == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if( portBYTE_ALIGNMENT != 8 )
+	#error heap_tlsf.c asume portBYTE_ALIGNMENT == 8
+#endif
+
+/* Segundo nivel: 16 sublistas por potencia de 2. */
+#define tlsfSL_INDEX_COUNT_LOG2		( 4 )
+#define tlsfSL_INDEX_COUNT			( 1UL << tlsfSL_INDEX_COUNT_LOG2 )
+#define tlsfALIGN_SIZE_LOG2			( 3 )
+#define tlsfALIGN_SIZE				( 1UL << tlsfALIGN_SIZE_LOG2 )
+
+/* Primer nivel: por debajo de tlsfSMALL_BLOCK_SIZE (128 B) las sublistas son
+lineales (de a 8 bytes); por encima, cada potencia de 2 se divide en 16. */
+#define tlsfFL_INDEX_MAX			( 16 )	/* bloques de hasta 64 KB */
+#define tlsfFL_INDEX_SHIFT			( tlsfSL_INDEX_COUNT_LOG2 + tlsfALIGN_SIZE_LOG2 )
+#define tlsfFL_INDEX_COUNT			( tlsfFL_INDEX_MAX - tlsfFL_INDEX_SHIFT + 1 )
+#define tlsfSMALL_BLOCK_SIZE		( 1UL << tlsfFL_INDEX_SHIFT )
+
+#define tlsfBLOCK_FREE_BIT			( ( size_t ) 1 )
+#define tlsfBLOCK_TAG_SHIFT			( 24 )
+#define tlsfBLOCK_TAG_MASK			( ( size_t ) 0xFF << tlsfBLOCK_TAG_SHIFT )
+#define tlsfBLOCK_SIZE_MASK			( ~( ( size_t ) tlsfALIGN_SIZE - 1 ) & ~tlsfBLOCK_TAG_MASK )
+#define tlsfBLOCK_SIZE_MAX			( ( size_t ) 1 << tlsfFL_INDEX_MAX )
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+typedef struct TLSF_BLOCK
+{
+	struct TLSF_BLOCK *pxPrevPhys;	/*<< Bloque fisico anterior (NULL en el primero). */
+	size_t xSize;					/*<< Tamano del payload; bit 0 = bloque libre. */
+	struct TLSF_BLOCK *pxNextFree;	/*<< Solo en bloques libres (ocupa el payload). */
+	struct TLSF_BLOCK *pxPrevFree;
+} TlsfBlock_t;
+
+#define tlsfHEADER_SIZE				( offsetof( TlsfBlock_t, pxNextFree ) )
+#define tlsfMIN_PAYLOAD				( sizeof( TlsfBlock_t ) - tlsfHEADER_SIZE )
+
+/* Con configAPP_HEAP_TRACE, un bloque asignado guarda en los bits 24-31 de xSize
+(los tamanos no pasan de 64 KB) la marca de heap_trace.c con el sitio que lo
+pidio; 0 es sin marca. Los bloques libres quedan siempre sin marca. */
+#if defined( configAPP_HEAP_TRACE ) && ( configAPP_HEAP_TRACE == 1 )
+	#define tlsfBLOCK_OF( pv )			( ( TlsfBlock_t * ) ( ( ( uint8_t * ) ( pv ) ) - tlsfHEADER_SIZE ) )
+	#define heapTAG_SET( pv, ucTag )	do { uint8_t ucT = ( ucTag ); if( ( pv ) != NULL ) { tlsfBLOCK_OF( pv )->xSize = ( tlsfBLOCK_OF( pv )->xSize & ~tlsfBLOCK_TAG_MASK ) | ( ( size_t ) ucT << tlsfBLOCK_TAG_SHIFT ); } } while( 0 )
+	#define heapTAG_GET( pv )			( ( uint8_t ) ( tlsfBLOCK_OF( pv )->xSize >> tlsfBLOCK_TAG_SHIFT ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void );
+static void prvMappingInsert( size_t xSize, UBaseType_t *puxFl, UBaseType_t *puxSl );
+static TlsfBlock_t *prvSearchSuitableBlock( size_t xSize, UBaseType_t *puxFl, UBaseType_t *puxSl );
+static void prvInsertFreeBlock( TlsfBlock_t *pxBlock );
+static void prvRemoveFreeBlock( TlsfBlock_t *pxBlock, UBaseType_t uxFl, UBaseType_t uxSl );
+static void prvRemoveFreeBlockAnyList( TlsfBlock_t *pxBlock );
+
+/*-----------------------------------------------------------*/
+
+static uint32_t ulFlBitmap = 0;
+static uint32_t ulSlBitmap[ tlsfFL_INDEX_COUNT ];
+static TlsfBlock_t *pxFreeLists[ tlsfFL_INDEX_COUNT ][ tlsfSL_INDEX_COUNT ];
+static TlsfBlock_t *pxFirstBlock = NULL;
+
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+static inline size_t prvBlockSize( const TlsfBlock_t *pxBlock )
+{
+	return pxBlock->xSize & tlsfBLOCK_SIZE_MASK;
+}
+
+static inline BaseType_t prvBlockIsFree( const TlsfBlock_t *pxBlock )
+{
+	return ( pxBlock->xSize & tlsfBLOCK_FREE_BIT ) != 0;
+}
+
+static inline TlsfBlock_t *prvBlockNext( const TlsfBlock_t *pxBlock )
+{
+	return ( TlsfBlock_t * ) ( ( ( uint8_t * ) pxBlock ) + tlsfHEADER_SIZE + prvBlockSize( pxBlock ) );
+}
+
+/* fls/ffs en O(1): CLZ y RBIT+CLZ en Cortex-M4. */
+static inline UBaseType_t prvFls( uint32_t ulWord )
+{
+	return ( UBaseType_t ) ( 31 - __builtin_clz( ulWord ) );
+}
+
+static inline UBaseType_t prvFfs( uint32_t ulWord )
+{
+	return ( UBaseType_t ) __builtin_ctz( ulWord );
+}
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+TlsfBlock_t *pxBlock, *pxRemaining;
+UBaseType_t uxFl, uxSl;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		if( pxFirstBlock == NULL )
+		{
+			prvHeapInit();
+		}
+
+		if( ( xWantedSize > 0 ) && ( xWantedSize < tlsfBLOCK_SIZE_MAX ) )
+		{
+			xWantedSize = ( xWantedSize + ( tlsfALIGN_SIZE - 1 ) ) & tlsfBLOCK_SIZE_MASK;
+
+			if( xWantedSize < tlsfMIN_PAYLOAD )
+			{
+				xWantedSize = tlsfMIN_PAYLOAD;
+			}
+
+			pxBlock = prvSearchSuitableBlock( xWantedSize, &uxFl, &uxSl );
+
+			if( pxBlock != NULL )
+			{
+				prvRemoveFreeBlock( pxBlock, uxFl, uxSl );
+
+				/* Dividir si el sobrante alcanza para otro bloque. */
+				if( prvBlockSize( pxBlock ) >= ( xWantedSize + tlsfHEADER_SIZE + tlsfMIN_PAYLOAD ) )
+				{
+					pxRemaining = ( TlsfBlock_t * ) ( ( ( uint8_t * ) pxBlock ) + tlsfHEADER_SIZE + xWantedSize );
+					pxRemaining->pxPrevPhys = pxBlock;
+					pxRemaining->xSize = ( prvBlockSize( pxBlock ) - xWantedSize - tlsfHEADER_SIZE ) | tlsfBLOCK_FREE_BIT;
+					prvBlockNext( pxRemaining )->pxPrevPhys = pxRemaining;
+					pxBlock->xSize = xWantedSize;
+					prvInsertFreeBlock( pxRemaining );
+				}
+				else
+				{
+					pxBlock->xSize = prvBlockSize( pxBlock );
+				}
+
+				xFreeBytesRemaining -= prvBlockSize( pxBlock ) + tlsfHEADER_SIZE;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + tlsfHEADER_SIZE );
+				xNumberOfSuccessfulAllocations++;
+			}
+		}
+
+		traceMALLOC( pvReturn, ( pvReturn != NULL ) ? ( xWantedSize + tlsfHEADER_SIZE ) : xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+TlsfBlock_t *pxBlock, *pxNeighbour;
+size_t xFreedSize;
+
+	if( pv == NULL )
+	{
+		return;
+	}
+
+	pxBlock = ( TlsfBlock_t * ) ( ( ( uint8_t * ) pv ) - tlsfHEADER_SIZE );
+	configASSERT( prvBlockIsFree( pxBlock ) == pdFALSE );
+
+	vTaskSuspendAll();
+	{
+		xFreedSize = prvBlockSize( pxBlock ) + tlsfHEADER_SIZE;
+		xFreeBytesRemaining += xFreedSize;
+		traceFREE( pv, xFreedSize );
+
+		/* Fusionar con el bloque fisico anterior si esta libre. */
+		pxNeighbour = pxBlock->pxPrevPhys;
+
+		if( ( pxNeighbour != NULL ) && prvBlockIsFree( pxNeighbour ) )
+		{
+			prvRemoveFreeBlockAnyList( pxNeighbour );
+			pxNeighbour->xSize = prvBlockSize( pxNeighbour ) + tlsfHEADER_SIZE + prvBlockSize( pxBlock );
+			pxBlock = pxNeighbour;
+		}
+
+		/* Fusionar con el siguiente (el centinela final nunca esta libre). */
+		pxNeighbour = prvBlockNext( pxBlock );
+
+		if( prvBlockIsFree( pxNeighbour ) )
+		{
+			prvRemoveFreeBlockAnyList( pxNeighbour );
+			pxBlock->xSize = prvBlockSize( pxBlock ) + tlsfHEADER_SIZE + prvBlockSize( pxNeighbour );
+		}
+
+		pxBlock->xSize = prvBlockSize( pxBlock ) | tlsfBLOCK_FREE_BIT;
+		prvBlockNext( pxBlock )->pxPrevPhys = pxBlock;
+		prvInsertFreeBlock( pxBlock );
+		xNumberOfSuccessfulFrees++;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+/* Solo diagnostico: recorre los bloques fisicos, O(n). */
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+TlsfBlock_t *pxBlock;
+size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY;
+
+	vTaskSuspendAll();
+	{
+		for( pxBlock = pxFirstBlock; ( pxBlock != NULL ) && ( prvBlockSize( pxBlock ) != 0 ); pxBlock = prvBlockNext( pxBlock ) )
+		{
+			if( prvBlockIsFree( pxBlock ) )
+			{
+				xBlocks++;
+
+				if( prvBlockSize( pxBlock ) > xMaxSize )
+				{
+					xMaxSize = prvBlockSize( pxBlock );
+				}
+
+				if( prvBlockSize( pxBlock ) < xMinSize )
+				{
+					xMinSize = prvBlockSize( pxBlock );
+				}
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+	pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+	taskENTER_CRITICAL();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+TlsfBlock_t *pxSentinel;
+size_t xTotal = ( ( size_t ) configTOTAL_HEAP_SIZE ) & tlsfBLOCK_SIZE_MASK;
+
+	/* El mapa de niveles cubre bloques de hasta 2^tlsfFL_INDEX_MAX bytes. */
+	configASSERT( xTotal < tlsfBLOCK_SIZE_MAX );
+
+	/* Un unico bloque libre y un centinela final de tamano 0, siempre ocupado. */
+	pxFirstBlock = ( TlsfBlock_t * ) ucHeap;
+	pxFirstBlock->pxPrevPhys = NULL;
+	pxFirstBlock->xSize = ( xTotal - ( 2 * tlsfHEADER_SIZE ) ) | tlsfBLOCK_FREE_BIT;
+
+	pxSentinel = prvBlockNext( pxFirstBlock );
+	pxSentinel->pxPrevPhys = pxFirstBlock;
+	pxSentinel->xSize = 0;
+
+	prvInsertFreeBlock( pxFirstBlock );
+	xFreeBytesRemaining = xTotal - tlsfHEADER_SIZE;
+	xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize, UBaseType_t *puxFl, UBaseType_t *puxSl )
+{
+UBaseType_t uxFl, uxSl;
+
+	if( xSize < tlsfSMALL_BLOCK_SIZE )
+	{
+		uxFl = 0;
+		uxSl = ( UBaseType_t ) ( xSize / ( tlsfSMALL_BLOCK_SIZE / tlsfSL_INDEX_COUNT ) );
+	}
+	else
+	{
+		uxFl = prvFls( ( uint32_t ) xSize );
+		uxSl = ( UBaseType_t ) ( ( xSize >> ( uxFl - tlsfSL_INDEX_COUNT_LOG2 ) ) ^ tlsfSL_INDEX_COUNT );
+		uxFl -= ( tlsfFL_INDEX_SHIFT - 1 );
+	}
+
+	*puxFl = uxFl;
+	*puxSl = uxSl;
+}
+/*-----------------------------------------------------------*/
+
+/* Redondea el pedido hacia arriba a la siguiente sublista, asi cualquier bloque
+de la lista encontrada alcanza: no hace falta recorrerla (O(1)). Si no hay
+ninguna, se prueba solo la cabeza de la sublista exacta del pedido (tambien
+O(1)), para no rechazar un bloque grande que alcanzaria justo. */
+static TlsfBlock_t *prvSearchSuitableBlock( size_t xSize, UBaseType_t *puxFl, UBaseType_t *puxSl )
+{
+UBaseType_t uxFl, uxSl;
+uint32_t ulSlMap, ulFlMap;
+size_t xRounded = xSize;
+
+	if( xSize >= tlsfSMALL_BLOCK_SIZE )
+	{
+		xRounded += ( ( size_t ) 1 << ( prvFls( ( uint32_t ) xSize ) - tlsfSL_INDEX_COUNT_LOG2 ) ) - 1;
+	}
+
+	prvMappingInsert( xRounded, &uxFl, &uxSl );
+
+	ulSlMap = ( uxFl < tlsfFL_INDEX_COUNT ) ? ( ulSlBitmap[ uxFl ] & ( ~0UL << uxSl ) ) : 0;
+
+	if( ulSlMap == 0 )
+	{
+		ulFlMap = ( uxFl + 1 < tlsfFL_INDEX_COUNT ) ? ( ulFlBitmap & ( ~0UL << ( uxFl + 1 ) ) ) : 0;
+
+		if( ulFlMap == 0 )
+		{
+			prvMappingInsert( xSize, &uxFl, &uxSl );
+
+			if( ( uxFl < tlsfFL_INDEX_COUNT ) && ( pxFreeLists[ uxFl ][ uxSl ] != NULL ) &&
+				( prvBlockSize( pxFreeLists[ uxFl ][ uxSl ] ) >= xSize ) )
+			{
+				*puxFl = uxFl;
+				*puxSl = uxSl;
+				return pxFreeLists[ uxFl ][ uxSl ];
+			}
+
+			return NULL;
+		}
+
+		uxFl = prvFfs( ulFlMap );
+		ulSlMap = ulSlBitmap[ uxFl ];
+	}
+
+	uxSl = prvFfs( ulSlMap );
+	*puxFl = uxFl;
+	*puxSl = uxSl;
+	return pxFreeLists[ uxFl ][ uxSl ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TlsfBlock_t *pxBlock )
+{
+UBaseType_t uxFl, uxSl;
+TlsfBlock_t *pxHead;
+
+	prvMappingInsert( prvBlockSize( pxBlock ), &uxFl, &uxSl );
+	pxHead = pxFreeLists[ uxFl ][ uxSl ];
+
+	pxBlock->pxPrevFree = NULL;
+	pxBlock->pxNextFree = pxHead;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPrevFree = pxBlock;
+	}
+
+	pxFreeLists[ uxFl ][ uxSl ] = pxBlock;
+	ulFlBitmap |= ( 1UL << uxFl );
+	ulSlBitmap[ uxFl ] |= ( 1UL << uxSl );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TlsfBlock_t *pxBlock, UBaseType_t uxFl, UBaseType_t uxSl )
+{
+	if( pxBlock->pxPrevFree != NULL )
+	{
+		pxBlock->pxPrevFree->pxNextFree = pxBlock->pxNextFree;
+	}
+	else
+	{
+		pxFreeLists[ uxFl ][ uxSl ] = pxBlock->pxNextFree;
+	}
+
+	if( pxBlock->pxNextFree != NULL )
+	{
+		pxBlock->pxNextFree->pxPrevFree = pxBlock->pxPrevFree;
+	}
+
+	if( pxFreeLists[ uxFl ][ uxSl ] == NULL )
+	{
+		ulSlBitmap[ uxFl ] &= ~( 1UL << uxSl );
+
+		if( ulSlBitmap[ uxFl ] == 0 )
+		{
+			ulFlBitmap &= ~( 1UL << uxFl );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlockAnyList( TlsfBlock_t *pxBlock )
+{
+UBaseType_t uxFl, uxSl;
+
+	prvMappingInsert( prvBlockSize( pxBlock ), &uxFl, &uxSl );
+	prvRemoveFreeBlock( pxBlock, uxFl, uxSl );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configAPP_HEAP_TLSF */
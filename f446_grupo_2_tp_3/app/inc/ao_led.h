@@ -11,8 +11,29 @@
 //#include "ao_ui.h"
 
 /********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
 
 /********************** macros ***********************************************/
+/* Tiempo de encendido adaptativo: con AO_LED_CONFIG_ADAPTIVE_HOLD en 1 el tiempo
+ * que se mantiene encendido cada LED se acorta segun la cantidad de pedidos
+ * pendientes en la cola de prioridad, sin bajar de AO_LED_CONFIG_HOLD_MIN_MS.
+ * Con 0 se usa siempre AO_LED_CONFIG_HOLD_MAX_MS (comportamiento original).
+ * HOLD_MAX es el valor por defecto de PARAM_LED_HOLD_MS (params.c). */
+#define AO_LED_CONFIG_ADAPTIVE_HOLD             (0)
+#define AO_LED_CONFIG_HOLD_MAX_MS               (5000)
+#define AO_LED_CONFIG_HOLD_MIN_MS               (1000)
+
+/* Desalojo: con AO_LED_CONFIG_PREEMPT en 1, si llega un pedido de mayor prioridad
+ * mientras un LED esta encendido, se apaga el LED actual, se reencola lo que le
+ * faltaba al frente de su prioridad y se atiende enseguida el pedido nuevo. */
+#define AO_LED_CONFIG_PREEMPT                   (0)
+
+/* Carriles por color: con AO_LED_CONFIG_PARALLEL en 1 cada LED (rojo, verde, azul)
+ * es un carril independiente y pueden estar encendidos a la vez. Los pedidos se
+ * siguen sacando de la cola en orden de prioridad; cada carril tiene un lugar de
+ * espera y el desalojo (AO_LED_CONFIG_PREEMPT) se aplica dentro del carril. */
+#define AO_LED_CONFIG_PARALLEL                  (0)
 
 /********************** typedef **********************************************/
 typedef enum {
@@ -27,12 +48,14 @@ typedef enum {
   AO_LED_COLOR_RED,
   AO_LED_COLOR_GREEN,
   AO_LED_COLOR_BLUE,
+  AO_LED_COLOR__N,
 } ao_led_color_t;
 
 typedef struct {
 
 	ao_led_action_t action;
 	ao_led_color_t color;
+	uint32_t hold_ms;	/* 0: tiempo calculado por AO LED; != 0: tiempo restante de un pedido desalojado. */
 } data_queue_t;
 
 
@@ -40,6 +63,8 @@ typedef struct {
 
 /********************** external functions declaration ***********************/
 bool ao_led_init();
+uint32_t ao_led_get_hold_ms(void);
+uint32_t ao_led_get_holds_done(void);
 
 
 #endif /* INC_AO_LED_H_ */
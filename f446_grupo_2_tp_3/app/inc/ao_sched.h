@@ -0,0 +1,44 @@
+/*
+ * ao_sched.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_AO_SCHED_H_
+#define INC_AO_SCHED_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pt.h"
+
+/********************** macros ***********************************************/
+/* Planificador cooperativo de objetos activos sin stack: una sola tarea
+ * (task_ao) corre todos los protothreads registrados por turno y duerme hasta
+ * el plazo mas cercano o hasta que alguien la notifique (ao_sched_signal(), o
+ * una insercion en la cola de prioridad, que tiene a task_ao como consumidor). */
+#define AO_SCHED_CONFIG_MAX_AO          (4)
+#define AO_SCHED_CONFIG_STACK_SIZE      (192)	/* compartido: el camino mas profundo de cualquier AO */
+
+/********************** typedef **********************************************/
+typedef int (*ao_sched_fn_t)(pt_t * pt);
+
+typedef struct {
+
+	uint32_t passes;			/* vueltas del planificador */
+	uint32_t events;			/* vueltas disparadas por notificacion */
+	uint32_t pass_cycles_max;	/* vuelta mas larga: bloqueo maximo entre AO */
+	uint16_t ram_bytes;			/* TCB + stack compartido + estado de todos los AO */
+	uint8_t ao_n;
+} ao_sched_stats_t;
+
+/********************** external functions declaration ***********************/
+bool ao_sched_init(void);
+bool ao_sched_add(ao_sched_fn_t fn);
+void ao_sched_signal(void);
+TaskHandle_t ao_sched_handle(void);
+void ao_sched_get_stats(ao_sched_stats_t * stats);
+
+#endif /* INC_AO_SCHED_H_ */
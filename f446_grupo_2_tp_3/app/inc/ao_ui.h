@@ -10,9 +10,23 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "ao_led.h"
 
+/********************** macros ***********************************************/
+/* Limitador de tasa por tipo de evento a la entrada de la UI (token bucket). La
+ * tasa y la rafaga de cada evento se configuran en ao_ui.c. Los eventos
+ * rechazados no se loguean: solo se cuentan (ao_ui_get_rejected). */
+#define AO_UI_CONFIG_RATE_LIMIT         (1)
+
+/* Histograma de la latencia de despacho: cubeta i = [2^(i-1), 2^i) us, la
+ * primera es < 1 us y la ultima junta todo lo que no entra. */
+#define AO_UI_LATENCY_BUCKETS           (12)
+
+/* Capacidad de la cola de eventos; el largo en uso es PARAM_UI_QUEUE_LEN. */
+#define AO_UI_QUEUE_LENGTH              (10)
+
 /********************** typedef **********************************************/
 typedef enum {
 
@@ -26,5 +40,11 @@ typedef enum {
 /********************** external functions declaration ***********************/
 bool ao_ui_init(void);
 bool ao_ui_send_event(msg_event_t event);
+bool ao_ui_send_console_event(msg_event_t event);	/* igual, marcado como de la consola */
+uint32_t ao_ui_get_rejected(msg_event_t event);
+void ao_ui_get_latency(uint32_t * avg_cycles, uint32_t * max_cycles);
+void ao_ui_get_latency_hist(uint32_t hist[AO_UI_LATENCY_BUCKETS]);
+uint8_t ao_ui_get_queue_depth(void);
+void ao_ui_reset_stats(void);
 
 #endif /* INC_AO_UI_H_ */
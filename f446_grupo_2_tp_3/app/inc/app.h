@@ -41,8 +41,19 @@ extern "C" {
 #endif
 
 /********************** inclusions *******************************************/
+#include <stddef.h>
 
 /********************** macros ***********************************************/
+/* Arranque sin heap: con APP_CONFIG_STATIC_ALLOCATION en 1 todas las tareas,
+ * colas y semaforos de la aplicacion (y los nodos de la cola de prioridad) se
+ * crean sobre memoria reservada estaticamente. Al iniciar se informa la RAM
+ * estatica de cada objeto y el heap libre que queda. */
+#define APP_CONFIG_STATIC_ALLOCATION      (1)
+
+/* Objetos activos sin stack: con APP_CONFIG_STACKLESS_AO en 1 task_button,
+ * task_ao_ui y task_led se reemplazan por protothreads que corren juntos en
+ * una sola tarea (ao_sched.c) con un unico stack. Requiere AO_LED_CONFIG_PARALLEL. */
+#define APP_CONFIG_STACKLESS_AO           (0)
 
 /********************** typedef **********************************************/
 
@@ -50,6 +61,7 @@ extern "C" {
 
 /********************** external functions declaration ***********************/
 void app_init(void);
+void app_static_report(const char * name, size_t bytes);
 
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
@@ -0,0 +1,30 @@
+/*
+ * console.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_CONSOLE_H_
+#define INC_CONSOLE_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Consola de comandos por USART2: una tarea de baja prioridad lee lineas con
+ * uart_io_read() (DMA circular + IDLE, sin interrupcion por byte) y responde con
+ * uart_io_write(). Las respuestas son texto y conviven con las tramas de
+ * telemetria (tools/telemetry.py las muestra tal cual). No hay eco: usar el
+ * eco local de la terminal. "help" lista los comandos. */
+#define CONSOLE_CONFIG_ENABLE           (1)
+#define CONSOLE_CONFIG_LINE_LEN         (64)
+#define CONSOLE_CONFIG_MAX_ARGS         (4)
+#define CONSOLE_CONFIG_PRIORITY         (tskIDLE_PRIORITY)
+#define CONSOLE_CONFIG_STACK_SIZE       (256)
+
+/********************** external functions declaration ***********************/
+bool console_init(void);
+
+#endif /* INC_CONSOLE_H_ */
@@ -0,0 +1,41 @@
+/*
+ * cpu_load.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_CPU_LOAD_H_
+#define INC_CPU_LOAD_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Carga de CPU medida desde vApplicationIdleHook(): cada vuelta del idle mide
+ * con DWT el tiempo desde la vuelta anterior. Si es menor que
+ * CPU_LOAD_CONFIG_GAP_FACTOR veces la vuelta mas corta observada (calibracion
+ * continua), ese tiempo fue idle; si no, corrio otra tarea o una ISR y se
+ * descarta. El idle se acumula en cubetas de 1 s (por tick del kernel) y la
+ * carga se informa sobre ventanas de 1, 10 y 60 s. */
+#define CPU_LOAD_CONFIG_ENABLE          (1)
+#define CPU_LOAD_CONFIG_GAP_FACTOR      (4)
+#define CPU_LOAD_CONFIG_HISTORY_S       (60)	/* cubetas de 1 s guardadas */
+
+/********************** typedef **********************************************/
+typedef struct {
+
+	uint16_t load_1s_pm;		/* carga en por mil, ultima ventana cerrada de 1 s */
+	uint16_t load_10s_pm;
+	uint16_t load_60s_pm;
+	uint16_t seconds;			/* cubetas validas (satura en CPU_LOAD_CONFIG_HISTORY_S) */
+	uint32_t idle_loop_cycles;	/* vuelta mas corta del idle: calibracion */
+} cpu_load_t;
+
+/********************** external functions declaration ***********************/
+void cpu_load_on_idle(void);
+void cpu_load_credit_idle(uint32_t cycles);
+bool cpu_load_get(cpu_load_t * load);
+
+#endif /* INC_CPU_LOAD_H_ */
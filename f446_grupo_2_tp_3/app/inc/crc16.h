@@ -0,0 +1,23 @@
+/*
+ * crc16.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_CRC16_H_
+#define INC_CRC16_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/********************** macros ***********************************************/
+/* CRC-16/CCITT-FALSE: polinomio 0x1021, valor inicial 0xFFFF, sin reflejar.
+ * Tabla de 16 entradas (un nibble por paso): 32 B de flash. */
+#define CRC16_INIT                      (0xFFFFu)
+
+/********************** external functions declaration ***********************/
+uint16_t crc16_update(uint16_t crc, const uint8_t * data, size_t len);
+
+#endif /* INC_CRC16_H_ */
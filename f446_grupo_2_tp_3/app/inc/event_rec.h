@@ -0,0 +1,71 @@
+/*
+ * event_rec.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_EVENT_REC_H_
+#define INC_EVENT_REC_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Grabador de entradas de AO UI: cada envio (boton o comando "ev" de la
+ * consola) deja un registro con tick, CYCCNT, evento, origen, resultado y
+ * profundidad de las colas UI y de prioridad, en un anillo que pisa lo mas
+ * viejo. Un rechazo o una cola de prioridad con EVENT_REC_CONFIG_TRIGGER_DEPTH
+ * pedidos dispara el volcado por el logger desde task_monitor; el comando
+ * "evrec" de la consola lo vuelca por uart_io cuando se quiera.
+ *
+ * El volcado trae el CSV del anillo y, debajo, las mismas entradas como
+ * scenario_input_t. Esas lineas se pegan en scenario_table.c para repetir la
+ * secuencia, con configAPP_VIRTUAL_TIME si conviene. task_button muestrea con
+ * vTaskDelayUntil, asi que los eventos del boton caen en la misma grilla de
+ * PARAM_BTN_PERIOD_MS que recorre la repeticion. Los de la consola llegan
+ * fuera de esa grilla y no se pueden inyectar como entradas del boton: salen
+ * comentados. La repeticion reproduce la secuencia del boton, no los tiempos
+ * de las demas tareas; su CSV se compara en las columnas res, ui y pq, y el
+ * anillo tiene que arrancar con las colas vacias (ver el primer registro). */
+#define EVENT_REC_CONFIG_ENABLE             (1)
+#define EVENT_REC_CONFIG_LEN                (64)
+#define EVENT_REC_CONFIG_TRIGGER_DEPTH      (8)
+
+/********************** typedef **********************************************/
+typedef enum {
+
+	EVENT_REC_OK,
+	EVENT_REC_RATE_LIMITED,		/* rechazado por el limitador de AO UI */
+	EVENT_REC_OVERFLOW,			/* aceptado descartando el mas viejo de la cola UI */
+} event_rec_result_t;
+
+typedef enum {
+
+	EVENT_REC_SRC_BUTTON,
+	EVENT_REC_SRC_CONSOLE,
+} event_rec_src_t;
+
+typedef struct {
+
+	uint32_t tick;
+	uint32_t cycles;
+	uint8_t event;
+	uint8_t result;
+	uint8_t ui_depth;
+	uint8_t pq_depth;
+	uint8_t src;				/* event_rec_src_t */
+} event_rec_t;
+
+/* Salida del volcado: una linea por llamada, sin fin de linea (como reply_ de
+ * la consola). */
+typedef void (*event_rec_print_t)(const char * fmt, ...);
+
+/********************** external functions declaration ***********************/
+void event_rec_on_send(uint8_t event, event_rec_result_t result, uint8_t ui_depth, event_rec_src_t src);
+bool event_rec_triggered(void);
+void event_rec_dump(void);
+bool event_rec_stream(event_rec_print_t print);
+
+#endif /* INC_EVENT_REC_H_ */
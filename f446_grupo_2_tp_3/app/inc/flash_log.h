@@ -0,0 +1,93 @@
+/*
+ * flash_log.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_FLASH_LOG_H_
+#define INC_FLASH_LOG_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cmsis_os.h"
+#include "log_store.h"
+
+/********************** macros ***********************************************/
+/* Registro persistente de metricas y fallas sobre log_store (sectores 6 y 7 de
+ * la flash). Los registros se juntan en RAM en dos buffers de una pagina: mientras
+ * una tarea de baja prioridad graba uno, los productores llenan el otro; si los
+ * dos estan ocupados el registro se descarta y se cuenta. Cada
+ * FLASH_LOG_CONFIG_SNAPSHOT_S se agrega una foto de metricas. Una falla pide
+ * grabar la pagina enseguida. Al arrancar se registra la causa de reset.
+ * Al llenarse un sector se borra el mas viejo, asi que siempre queda al menos
+ * un sector completo de historia. Borrar 128 KB lleva 1 a 2 s y, con un solo
+ * banco, detiene la CPU entera (interrupciones incluidas) mientras dura: pasa
+ * una vez cada unas 500 paginas, desde la tarea de grabacion. */
+#define FLASH_LOG_CONFIG_ENABLE         (1)
+#define FLASH_LOG_CONFIG_SNAPSHOT_S     (60)
+#define FLASH_LOG_CONFIG_PRIORITY       (tskIDLE_PRIORITY + 1)
+#define FLASH_LOG_CONFIG_STACK_SIZE     (192)
+#define FLASH_LOG_TAG_LEN               (8)
+
+/********************** typedef **********************************************/
+typedef enum {
+
+	FLASH_LOG_REC_METRICS = 1,
+	FLASH_LOG_REC_FAULT = 2,
+} flash_log_rec_type_t;
+
+typedef enum {
+
+	FLASH_LOG_FAULT_RESET = 1,		/* value: RCC->CSR del arranque */
+	FLASH_LOG_FAULT_STACK = 2,		/* value: palabras libres, tag: tarea */
+} flash_log_fault_code_t;
+
+typedef struct {
+
+	uint32_t cpu_1s_pm;				/* 0xFFFF sin dato */
+	uint32_t heap_free;
+	uint32_t heap_min;
+	uint32_t ui_rejected;			/* suma de los tres tipos de evento */
+	uint32_t pq_evicted;
+	uint32_t work_dropped;
+	uint32_t ui_latency_avg_us;
+	uint32_t ui_latency_max_us;
+	uint32_t stack_alarms;
+	uint32_t uart_tx_bytes;
+} flash_log_metrics_t;
+
+typedef struct {
+
+	uint32_t code;
+	uint32_t value;
+	char tag[FLASH_LOG_TAG_LEN];	/* sin terminador si ocupa todo */
+} flash_log_fault_t;
+
+typedef struct {
+
+	uint8_t type;
+	uint8_t len;
+	uint32_t tick;
+	union {
+
+		flash_log_metrics_t metrics;
+		flash_log_fault_t fault;
+		uint8_t raw[LOG_STORE_PAGE_DATA_SIZE];
+	} payload;
+} flash_log_rec_t;
+
+/* Devuelve false para cortar el recorrido. */
+typedef bool (*flash_log_cb_t)(const flash_log_rec_t * rec, void * ctx);
+
+/********************** external functions declaration ***********************/
+bool flash_log_init(void);
+bool flash_log_append(flash_log_rec_type_t type, const void * payload, uint8_t len);
+void flash_log_fault(flash_log_fault_code_t code, uint32_t value, const char * tag);
+bool flash_log_sync(TickType_t timeout);
+void flash_log_foreach(flash_log_cb_t cb, void * ctx);
+void flash_log_get_info(log_store_info_t * info, uint32_t * dropped);
+
+#endif /* INC_FLASH_LOG_H_ */
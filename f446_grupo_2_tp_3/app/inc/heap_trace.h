@@ -0,0 +1,75 @@
+/*
+ * heap_trace.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_HEAP_TRACE_H_
+#define INC_HEAP_TRACE_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/********************** macros ***********************************************/
+/* La captura se activa con configAPP_HEAP_TRACE en FreeRTOSConfig.h, que
+ * conecta traceMALLOC/traceFREE de heap_4 con este modulo. El sitio de llamada
+ * es la direccion de retorno de pvPortMalloc/vPortFree (resolver con addr2line).
+ * El heap guarda en la cabecera de cada bloque el sitio que lo asigno, asi el
+ * free se descuenta de ese sitio aunque lo libere otro. */
+#define HEAP_TRACE_CONFIG_MAX_SITES     (8)		/* sitios de llamada distintos */
+#define HEAP_TRACE_CONFIG_RING_LEN      (16)	/* ultimos eventos alloc/free; 0 = sin anillo */
+
+/* heap_trace_dump() vuelca el anillo como lineas "[HEAP] ev tick a|f puntero
+ * bytes" que tools/heap_replay reproduce sobre heap_4 y TLSF en la PC. Para una
+ * traza util conviene agrandar el anillo (16 B por evento). */
+#define HEAP_TRACE_CONFIG_HIST_BINS     (8)		/* bloques de 16, 32, ... 2048+ bytes */
+
+/********************** typedef **********************************************/
+typedef struct {
+
+	const void * site;
+	uint32_t allocs;
+	uint32_t frees;				/* de bloques asignados por este sitio */
+	uint32_t live_bytes;		/* bytes de bloque (con cabecera de heap_4) aun asignados */
+} heap_trace_site_t;
+
+typedef struct {
+
+	uint32_t tick;
+	const void * ptr;
+	const void * site;
+	uint16_t size;
+	uint8_t is_free;
+} heap_trace_event_t;
+
+typedef struct {
+
+	uint32_t allocs;
+	uint32_t frees;
+	uint32_t failed;
+	uint32_t live_bytes;
+	uint32_t peak_live_bytes;
+	uint32_t alloc_hist[HEAP_TRACE_CONFIG_HIST_BINS];	/* tamanos pedidos, potencias de 2 desde 16 B */
+	/* heap_4 */
+	size_t free_bytes;
+	size_t min_ever_free_bytes;
+	size_t largest_free_block;
+	size_t smallest_free_block;
+	size_t free_blocks;
+	uint8_t fragmentation_pct;	/* 100 * (1 - mayor bloque libre / libre total) */
+	/* newlib (malloc/_sbrk) */
+	size_t newlib_arena;
+	size_t newlib_used;
+} heap_trace_snapshot_t;
+
+/********************** external functions declaration ***********************/
+uint8_t heap_trace_on_malloc(void * ptr, size_t size, const void * site);
+void heap_trace_on_free(void * ptr, size_t size, const void * site, uint8_t tag);
+void heap_trace_snapshot(heap_trace_snapshot_t * snap);
+uint8_t heap_trace_get_sites(heap_trace_site_t * sites, uint8_t max);
+uint8_t heap_trace_get_events(heap_trace_event_t * events, uint8_t max);
+void heap_trace_dump(void);
+
+#endif /* INC_HEAP_TRACE_H_ */
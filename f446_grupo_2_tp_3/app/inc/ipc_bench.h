@@ -0,0 +1,37 @@
+/*
+ * ipc_bench.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_IPC_BENCH_H_
+#define INC_IPC_BENCH_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Benchmark de primitivas IPC: con IPC_BENCH_CONFIG_ENABLE en 1, app_init no
+ * crea la aplicacion. Una tarea de control y una de eco miden con DWT cola,
+ * notificacion, stream buffer, message buffer, semaforo y event group. Se
+ * prueban varios tamanos de payload y tres prioridades del receptor (mayor,
+ * igual o menor que el emisor). Cada caso da:
+ *  - rtt:    ciclos promedio de ida y vuelta (envio + eco);
+ *  - oneway: ciclos promedio desde antes del envio hasta que el receptor
+ *            retorna del recv;
+ *  - msg_s:  mensajes/s con IPC_BENCH_DEPTH en vuelo (0: la primitiva no
+ *            encola, p. ej. event group o notificacion con valor).
+ * La salida es CSV por el logger, una linea por caso, con encabezado. */
+#define IPC_BENCH_CONFIG_ENABLE         (0)
+#define IPC_BENCH_ITERATIONS            (200)
+#define IPC_BENCH_DEPTH                 (8)		/* mensajes en vuelo en colas y buffers */
+#define IPC_BENCH_MAX_PAYLOAD           (64)
+#define IPC_BENCH_PRIORITY              (tskIDLE_PRIORITY + 2)	/* emisor; el eco va +1, 0 o -1 */
+#define IPC_BENCH_STACK_SIZE            (256)
+
+/********************** external functions declaration ***********************/
+bool ipc_bench_init(void);
+
+#endif /* INC_IPC_BENCH_H_ */
@@ -0,0 +1,70 @@
+/*
+ * log_store.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_LOG_STORE_H_
+#define INC_LOG_STORE_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Almacen de paginas solo-agregar sobre uno o mas sectores de flash. La pagina 0
+ * de cada sector es su encabezado (magic, secuencia, borrados, CRC); el resto se
+ * escribe en orden, una pagina entera por vez, con encabezado (magic, bytes
+ * usados, CRC16 de los datos). Montar solo lee encabezados: el de cada sector
+ * y, con busqueda binaria, el primer word de las paginas del sector activo.
+ * Cuando el sector activo se llena se pasa al siguiente (el mas viejo), se lo
+ * borra y se le incrementa la cuenta de borrados: los sectores se gastan parejo
+ * y cada byte se programa una sola vez por borrado.
+ *
+ * No usa el RTOS: el acceso a la flash es por las funciones log_store_hw_*
+ * (log_store_hw.c en el micro; en la PC, el modelo en RAM de
+ * tools/log_store_host.c, que tambien prueba rotacion, montaje y cortes de
+ * alimentacion). El llamador serializa el acceso. */
+#define LOG_STORE_PAGE_SIZE             (256)
+#define LOG_STORE_PAGE_HDR_SIZE         (8)
+#define LOG_STORE_PAGE_DATA_SIZE        (LOG_STORE_PAGE_SIZE - LOG_STORE_PAGE_HDR_SIZE)
+
+/********************** typedef **********************************************/
+typedef struct {
+
+	uint8_t sectors;
+	uint8_t active;				/* sector en el que se escribe */
+	uint32_t seq;				/* secuencia del sector activo */
+	uint32_t erase_count;		/* borrados del sector activo */
+	uint32_t head_page;			/* proxima pagina libre del sector activo */
+	uint32_t pages_per_sector;	/* incluye la pagina de encabezado */
+} log_store_info_t;
+
+/* Recorrido por partes (log_store_read); en cero arranca por la pagina mas
+ * vieja. El sector se guarda por secuencia: si entre dos lecturas se lo borra
+ * al rotar, se sigue por el mas viejo que quede. */
+typedef struct {
+
+	uint32_t seq;
+	uint32_t page;				/* proxima pagina a leer */
+} log_store_cursor_t;
+
+/* Devuelve false para cortar el recorrido. */
+typedef bool (*log_store_page_cb_t)(const uint8_t * data, uint16_t used, void * ctx);
+
+/********************** external functions declaration ***********************/
+bool log_store_mount(void);
+bool log_store_write(const uint8_t * data, uint16_t used);
+void log_store_foreach(log_store_page_cb_t cb, void * ctx);
+bool log_store_read(log_store_cursor_t * cur, uint8_t * data, uint16_t * used);
+void log_store_get_info(log_store_info_t * info);
+
+/* Puerto: offset y largo de log_store_hw_program() son multiplos de 4. */
+uint8_t log_store_hw_sectors(void);
+const uint8_t * log_store_hw_base(uint8_t sector);
+uint32_t log_store_hw_size(uint8_t sector);
+bool log_store_hw_erase(uint8_t sector);
+bool log_store_hw_program(uint8_t sector, uint32_t offset, const uint8_t * data, uint32_t len);
+
+#endif /* INC_LOG_STORE_H_ */
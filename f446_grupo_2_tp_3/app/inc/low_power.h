@@ -0,0 +1,42 @@
+/*
+ * low_power.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_LOW_POWER_H_
+#define INC_LOW_POWER_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Idle tickless: con configAPP_TICKLESS_IDLE en FreeRTOSConfig.h el kernel
+ * reprograma SysTick para dormir (WFI) hasta la proxima tarea a despertar.
+ * Estos hooks corren antes y despues del WFI con interrupciones deshabilitadas:
+ * enmascaran la IRQ de la base de tiempo de la HAL (TIM1, 1 kHz), que si no
+ * despertaria al CPU en cada milisegundo, y miden cuanto se durmio realmente.
+ * TIM1 sigue contando: al despertar se suman a uwTick los ms que paso dormido,
+ * asi HAL_GetTick() no se atrasa (tiempos de escenario, vtime, timeouts de
+ * flash y UART). Con STRESS_TEST_CONFIG_ENABLE la IRQ de TIM1 no se toca,
+ * porque la prueba la usa como productor. */
+
+/********************** typedef **********************************************/
+typedef struct {
+
+	uint32_t sleeps;				/* entradas a WFI = despertares */
+	uint32_t early_wakeups;			/* despertadas por otra IRQ antes del plazo */
+	uint32_t requested_ticks;		/* ticks pedidos por el kernel, acumulado */
+	uint64_t slept_cycles;			/* tiempo dormido medido con SysTick */
+	uint16_t residency_pm;			/* tiempo dormido / tiempo total, por mil */
+	uint16_t wakeups_per_s;
+} low_power_stats_t;
+
+/********************** external functions declaration ***********************/
+void low_power_pre_sleep(uint32_t * idle_ticks);
+void low_power_post_sleep(uint32_t expected_ticks);
+void low_power_get_stats(low_power_stats_t * stats);
+
+#endif /* INC_LOW_POWER_H_ */
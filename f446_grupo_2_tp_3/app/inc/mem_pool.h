@@ -0,0 +1,60 @@
+/*
+ * mem_pool.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_MEM_POOL_H_
+#define INC_MEM_POOL_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "app.h"
+
+/********************** macros ***********************************************/
+/* Pools de bloques fijos por clase de tamano, separados de heap_4 y de newlib.
+ * Alloc/free en tiempo acotado (a lo sumo MEM_POOL_CLASS_N clases recorridas),
+ * protegidos con seccion critica: usables desde cualquier tarea (un USB host
+ * podria apuntar USBH_malloc/USBH_free aca, tienen la firma de malloc/free).
+ * Hoy el unico usuario son los nodos de la cola de prioridad en el arranque
+ * dinamico: con APP_CONFIG_STATIC_ALLOCATION los nodos salen de su propio
+ * arreglo, asi que el pool se apaga solo y no reserva su arena. */
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+#define MEM_POOL_CONFIG_ENABLE          (0)
+#else
+#define MEM_POOL_CONFIG_ENABLE          (1)
+#endif
+#define MEM_POOL_CONFIG_SPILL           (1)		/* clase agotada: probar la siguiente mas grande */
+
+/* X(tamano de bloque en bytes, cantidad de bloques): tamanos multiplos de 8 y crecientes. */
+#define MEM_POOL_CLASSES(X)             X(32, 16) X(64, 8) X(256, 4) X(512, 2)
+
+#define MEM_POOL_COUNT_(size, blocks)   + 1
+#define MEM_POOL_CLASS_N                (0 MEM_POOL_CLASSES(MEM_POOL_COUNT_))
+
+/********************** typedef **********************************************/
+typedef struct {
+
+	uint16_t block_size;
+	uint16_t blocks;
+	uint16_t used;
+	uint16_t peak;
+	uint32_t allocs;
+	uint32_t spills;		/* pedidos servidos por una clase mas grande */
+	uint32_t fails;			/* pedidos que llegaron a esta clase y no encontraron bloque */
+} mem_pool_stats_t;
+
+/********************** external functions declaration ***********************/
+void mem_pool_init(void);
+void * mem_pool_alloc(size_t size);
+void mem_pool_free(void * ptr);
+bool mem_pool_owns(const void * ptr);
+bool mem_pool_get_stats(uint8_t cls, mem_pool_stats_t * stats);
+size_t mem_pool_static_size(void);
+void mem_pool_dump(void);
+
+#endif /* INC_MEM_POOL_H_ */
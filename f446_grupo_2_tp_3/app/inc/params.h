@@ -0,0 +1,81 @@
+/*
+ * params.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_PARAMS_H_
+#define INC_PARAMS_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Registro central de parametros de tiempo y tamano. Escritura: param_set()
+ * valida rango y coherencia y publica con un seqlock (contador impar mientras se
+ * copia). Lectura: param_get() es una carga de 32 bits, sin espera; cuando varios
+ * valores tienen que ser coherentes entre si se usa params_snapshot(), que solo
+ * reintenta si una escritura coincidio con la copia.
+ *
+ * Persistencia: params_save() agrega un registro (valores + CRC16 + numero de
+ * secuencia) al final del sector en uso; al arrancar vale el registro valido
+ * de mayor secuencia de los dos sectores. Cuando el sector en uso se llena (unos
+ * 370 guardados) se borra el otro y el registro nuevo va ahi: el anterior sigue
+ * grabado hasta que el nuevo esta completo, asi que un corte en cualquier punto
+ * deja uno de los dos. Un guardado sin cambios no escribe. Mientras se programa
+ * o borra la flash la CPU queda detenida (un solo banco): guardar es una accion
+ * explicita de la consola, nunca del camino de eventos. Son los sectores 2 y 3
+ * (16 KB): el linker los saltea. */
+#define PARAMS_CONFIG_PERSIST           (1)
+#define PARAMS_CONFIG_FLASH_SECTOR_A    (FLASH_SECTOR_2)
+#define PARAMS_CONFIG_FLASH_ADDR_A      (0x08008000u)
+#define PARAMS_CONFIG_FLASH_SECTOR_B    (FLASH_SECTOR_3)
+#define PARAMS_CONFIG_FLASH_ADDR_B      (0x0800C000u)
+#define PARAMS_CONFIG_FLASH_SIZE        (16u * 1024u)	/* cada uno */
+
+#define PARAM_F_BOOT                    (1u << 0)	/* se aplica en el proximo arranque */
+
+/********************** typedef **********************************************/
+typedef enum {
+
+	PARAM_BTN_PERIOD_MS,		/* muestreo del boton */
+	PARAM_BTN_PULSE_MS,
+	PARAM_BTN_SHORT_MS,
+	PARAM_BTN_LONG_MS,
+	PARAM_UI_PERIOD_MS,			/* pausa de AO UI entre eventos */
+	PARAM_UI_QUEUE_LEN,
+	PARAM_PQ_MAX_LEN,			/* largo maximo de la cola de prioridad de LED */
+	PARAM_LED_HOLD_MS,			/* encendido maximo (sin backlog) */
+	PARAM__N,
+} param_id_t;
+
+typedef struct {
+
+	uint32_t v[PARAM__N];
+} params_t;
+
+typedef struct {
+
+	const char * name;
+	uint32_t def;
+	uint32_t min;
+	uint32_t max;
+	uint8_t flags;
+} param_desc_t;
+
+/********************** external functions declaration ***********************/
+bool params_init(void);
+uint32_t param_get(param_id_t id);
+void params_snapshot(params_t * out);
+bool param_set(param_id_t id, uint32_t value);
+void params_defaults(void);
+uint32_t params_version(void);
+const param_desc_t * param_desc(param_id_t id);
+bool param_find(const char * name, param_id_t * id);
+#if 1 == PARAMS_CONFIG_PERSIST
+bool params_save(void);
+#endif
+
+#endif /* INC_PARAMS_H_ */
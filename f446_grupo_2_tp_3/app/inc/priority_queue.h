@@ -9,8 +9,29 @@
 #define INC_PRIORITY_QUEUE_H_
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "ao_led.h"
 
+#define PRIO_QUEUE_MAX_LENGTH        (10)		/* capacidad; el largo en uso es PARAM_PQ_MAX_LEN */
+
+/* Sincronizacion: con PRIO_QUEUE_CONFIG_NOTIFY en 1 la cola no usa semaforo ni
+ * mutex; la lista se protege con una seccion critica corta y el unico consumidor
+ * (registrado con prio_queue_register_consumer) se despierta con xTaskNotifyGive.
+ * Con 0 se usa el semaforo contador + mutex original (admite varios consumidores).
+ * Este y PRIO_QUEUE_CONFIG_SELFTEST se pueden fijar con -D (pruebas en tools/). */
+#ifndef PRIO_QUEUE_CONFIG_NOTIFY
+#define PRIO_QUEUE_CONFIG_NOTIFY     (0)
+#endif
+
+/* Medicion con DWT de los ciclos de insert/extract (solo extracciones que no bloquean). */
+#define PRIO_QUEUE_CONFIG_MEASURE    (1)
+
+/* Autoprueba aleatoria contra un modelo de referencia (priority_queue_test.c),
+ * corrida desde app_init antes de registrar al consumidor. */
+#ifndef PRIO_QUEUE_CONFIG_SELFTEST
+#define PRIO_QUEUE_CONFIG_SELFTEST   (0)
+#endif
+
 typedef enum {
 
   PRIO_QUEUE_PRIORITY_LOW,
@@ -18,9 +39,32 @@ typedef enum {
   PRIO_QUEUE_PRIORITY_HIGH
 } prio_queue_priority_t;
 
+typedef struct {
+
+	uint32_t insert_n;
+	uint32_t insert_cycles_avg;
+	uint32_t insert_cycles_max;
+	uint32_t extract_n;
+	uint32_t extract_cycles_avg;
+	uint32_t extract_cycles_max;
+} prio_queue_cycles_t;
+
 
 bool prio_queue_init();
 bool prio_queue_insert(data_queue_t data, prio_queue_priority_t priority);
+bool prio_queue_insert_front(data_queue_t data, prio_queue_priority_t priority);
 bool prio_queue_extract(data_queue_t * data, prio_queue_priority_t * priority, TickType_t timeout);
+bool prio_queue_peek_priority(prio_queue_priority_t * priority);
+void prio_queue_register_consumer(TaskHandle_t task);
+uint16_t prio_queue_count(void);
+uint16_t prio_queue_limit(void);
+/* Descartes por cola llena: el ultimo desalojado por una insercion, o el pedido
+ * de insert_front rechazado por no superar en prioridad al ultimo. */
+uint32_t prio_queue_evicted(void);
+void prio_queue_reset_evicted(void);
+void prio_queue_get_cycles(prio_queue_cycles_t * cycles);
+#if 1 == PRIO_QUEUE_CONFIG_SELFTEST
+bool prio_queue_check_integrity(void);
+#endif
 
 #endif /* INC_PRIORITY_QUEUE_H_ */
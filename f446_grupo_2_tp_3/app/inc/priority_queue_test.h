@@ -0,0 +1,34 @@
+/*
+ * priority_queue_test.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_PRIORITY_QUEUE_TEST_H_
+#define INC_PRIORITY_QUEUE_TEST_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Autoprueba de la cola de prioridad (PRIO_QUEUE_CONFIG_SELFTEST): episodios de
+ * operaciones aleatorias (insert, insert_front, extract; el desalojo y el
+ * rechazo de insert_front salen solos al llenar la cola) que se comparan contra
+ * un arreglo ordenado de referencia, junto con prio_queue_check_integrity()
+ * despues de cada paso. Un episodio que falla se reduce quitando operaciones
+ * mientras siga fallando y se loguea la secuencia minima. Las mediciones de
+ * PRIO_QUEUE_CONFIG_MEASURE incluyen la autoprueba.
+ *
+ * En el micro corre al arrancar, asi que se queda en pocos episodios; las
+ * corridas largas (millones de operaciones, todos los largos de cola) se hacen
+ * en la PC con tools/pq_test_host.c. */
+#define PRIO_QUEUE_TEST_EPISODES        (500)
+#define PRIO_QUEUE_TEST_SEQ_LEN         (48)
+#define PRIO_QUEUE_TEST_SEED            (0x2545F491u)	/* cambiarla para otra corrida */
+
+/********************** external functions declaration ***********************/
+bool prio_queue_selftest(uint32_t seed, uint32_t episodes);
+
+#endif /* INC_PRIORITY_QUEUE_TEST_H_ */
@@ -0,0 +1,80 @@
+/*
+ * pt.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_PT_H_
+#define INC_PT_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Protothreads (estilo Dunkels): continuaciones locales con switch/__LINE__.
+ * Un protothread no tiene stack propio: las variables que deban sobrevivir a
+ * una espera tienen que ser static, y no se puede esperar dentro de un switch
+ * propio. Las esperas devuelven el control al planificador (ao_sched), que
+ * vuelve a correr el protothread ante un evento o al vencer su plazo. */
+#define PT_WAITING              (0)
+#define PT_ENDED                (1)
+
+#define PT_INIT(pt)             do { (pt)->lc = 0; (pt)->armed = false; } while(0)
+
+#define PT_BEGIN(pt)            switch((pt)->lc) { case 0:
+
+#define PT_END(pt)              } (pt)->lc = 0; return PT_ENDED
+
+/* Espera hasta que cond sea verdadera; cond se evalua en cada pasada del planificador. */
+#define PT_WAIT_UNTIL(pt, cond)								\
+	do {													\
+		(pt)->lc = __LINE__; case __LINE__:					\
+		if(!(cond))											\
+			return PT_WAITING;								\
+	} while(0)
+
+/* Espera 'ticks' ticks del kernel. */
+#define PT_DELAY(pt, ticks)									\
+	do {													\
+		pt_arm_((pt), (ticks));								\
+		PT_WAIT_UNTIL((pt), pt_expired_(pt));				\
+		(pt)->armed = false;								\
+	} while(0)
+
+/* Cede al menos una vez y espera el proximo evento del planificador (una
+ * notificacion a task_ao) o 'ticks' ticks, lo que ocurra primero. Con
+ * portMAX_DELAY espera solo el evento. */
+#define PT_WAIT_EVENT(pt, ticks)							\
+	do {													\
+		pt_arm_((pt), (ticks));								\
+		(pt)->epoch = ao_sched_epoch();						\
+		PT_WAIT_UNTIL((pt), (pt)->epoch != ao_sched_epoch() || pt_expired_(pt));	\
+		(pt)->armed = false;								\
+	} while(0)
+
+/********************** typedef **********************************************/
+typedef struct {
+
+	uint16_t lc;			/* continuacion local: linea donde quedo esperando */
+	bool armed;				/* hay un plazo pendiente en wake */
+	TickType_t wake;
+	uint32_t epoch;
+} pt_t;
+
+/********************** external functions declaration ***********************/
+uint32_t ao_sched_epoch(void);
+
+static inline void pt_arm_(pt_t * pt, TickType_t ticks) {
+
+	pt->armed = (portMAX_DELAY != ticks);
+	pt->wake = xTaskGetTickCount() + ticks;
+}
+
+static inline bool pt_expired_(const pt_t * pt) {
+
+	return pt->armed && (int32_t)(xTaskGetTickCount() - pt->wake) >= 0;
+}
+
+#endif /* INC_PT_H_ */
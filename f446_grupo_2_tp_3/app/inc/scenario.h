@@ -0,0 +1,62 @@
+/*
+ * scenario.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_SCENARIO_H_
+#define INC_SCENARIO_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "task_button.h"
+#include "ao_led.h"
+
+/********************** macros ***********************************************/
+/* Escenarios de prueba: en modo TESTING_SIMULATION_BUTTON_INPUTS get_button_type()
+ * toma las entradas de scenario_table[] (flash) segun su marca de tiempo, en vez
+ * de un arreglo elegido al compilar. Cada escenario registra los flancos de los
+ * LED y, al terminar su tiempo de asentamiento, los compara con su salida de
+ * referencia (golden). Todos los escenarios corren en el mismo binario, uno
+ * detras de otro; con configAPP_VIRTUAL_TIME la corrida completa dura poco. */
+#define SCENARIO_CONFIG_TRACE_LEN           (32)
+#define SCENARIO_CONFIG_TOLERANCE_MS        (100)	/* periodo de muestreo del boton x 2 */
+
+#define SCENARIO_ANY_MS                     (UINT32_MAX)	/* golden: no se compara el instante */
+
+/********************** typedef **********************************************/
+typedef struct {
+
+	uint32_t at_ms;				/* desde el inicio del escenario */
+	button_type_t button;
+} scenario_input_t;
+
+typedef struct {
+
+	uint32_t at_ms;				/* desde el inicio del escenario, o SCENARIO_ANY_MS */
+	ao_led_color_t color;
+	bool on;
+} scenario_led_t;
+
+typedef struct {
+
+	const char * name;
+	const scenario_input_t * inputs;
+	uint8_t inputs_n;
+	const scenario_led_t * golden;	/* NULL: solo se vuelca la traza para capturarla */
+	uint8_t golden_n;
+	uint32_t settle_ms;				/* espera tras la ultima entrada antes de comparar */
+} scenario_t;
+
+/********************** external data declaration ****************************/
+extern const scenario_t scenario_table[];
+extern const uint16_t scenario_table_n;
+
+/********************** external functions declaration ***********************/
+button_type_t scenario_poll(void);
+void scenario_on_led(ao_led_color_t color, bool on);
+
+#endif /* INC_SCENARIO_H_ */
@@ -0,0 +1,36 @@
+/*
+ * stress_test.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_STRESS_TEST_H_
+#define INC_STRESS_TEST_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Prueba de concurrencia de las colas: con STRESS_TEST_CONFIG_ENABLE en 1,
+ * app_init no crea AO LED, AO UI ni task_button. En su lugar, 1..N tareas
+ * productoras (con time slicing entre ellas, el consumidor y los trabajadores)
+ * llenan la cola de prioridad y la cola de trabajos. El ISR de TIM1 tambien
+ * encola trabajos. Por ronda se verifica que no haya perdidos ni duplicados y
+ * que se respete el orden FIFO por productor y prioridad. Tambien se loguean
+ * las ops/s segun la cantidad de productores. La misma prueba, con hilos en
+ * paralelo y ThreadSanitizer, corre en la PC: tools/queue_stress_host.c. */
+#define STRESS_TEST_CONFIG_ENABLE       (0)
+#define STRESS_TEST_PRODUCERS           (3)
+#define STRESS_TEST_ITEMS               (1000)	/* por productor y ronda */
+#define STRESS_TEST_ISR_ITEMS           (64)	/* maximo desde TIM1 por ronda, uno por ms */
+#define STRESS_TEST_PRIORITY            (tskIDLE_PRIORITY + 1)	/* la de los trabajadores */
+#define STRESS_TEST_STACK_SIZE          (128)
+#define STRESS_TEST_CTRL_STACK_SIZE     (256)
+
+/********************** external functions declaration ***********************/
+bool stress_test_init(void);
+void stress_test_on_tick_isr(void);
+
+#endif /* INC_STRESS_TEST_H_ */
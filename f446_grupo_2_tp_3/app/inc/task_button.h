@@ -42,23 +42,28 @@ extern "C" {
 
 /********************** inclusions *******************************************/
 #include <ao_ui.h>
+#include "pt.h"
 /********************** macros ***********************************************/
 
 
-#define TESTING_SIMULATION_BUTTON_INPUTS /* esto ponerlo en el .h */
-
-#ifdef TESTING_SIMULATION_BUTTON_INPUTS
- #define TESTING_ARRAY_INPUTS_3 /* Elegir el numero de test que se va a correr en modo testing. */
-#endif
+#define TESTING_SIMULATION_BUTTON_INPUTS /* entradas desde la tabla de escenarios (scenario_table.c). */
 
 
 /********************** typedef **********************************************/
-typedef enum button_type_t button_type_t;
+typedef enum button_type_t {
+
+	BUTTON_TYPE_NONE,
+	BUTTON_TYPE_PULSE,
+	BUTTON_TYPE_SHORT,
+	BUTTON_TYPE_LONG,
+	BUTTON_TYPE__N,
+} button_type_t;
 /********************** external data declaration ****************************/
 
 /********************** external functions declaration ***********************/
 
 void task_button(void* argument);
+int task_button_pt(pt_t * pt);
 button_type_t get_button_type(void);
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
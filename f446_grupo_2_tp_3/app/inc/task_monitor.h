@@ -0,0 +1,44 @@
+/*
+ * task_monitor.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_TASK_MONITOR_H_
+#define INC_TASK_MONITOR_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Monitor de stack: cada TASK_MONITOR_CONFIG_PERIOD_MS muestrea la marca de agua
+ * de todas las tareas, guarda el minimo historico y cada
+ * TASK_MONITOR_CONFIG_REPORT_EVERY muestras informa el tamano recomendado
+ * (usado + margen). Si una tarea queda con menos de
+ * TASK_MONITOR_CONFIG_ALARM_WORDS palabras libres se emite una alarma (una vez). */
+#define TASK_MONITOR_CONFIG_ENABLE          (1)
+#define TASK_MONITOR_CONFIG_PERIOD_MS       (1000)
+#define TASK_MONITOR_CONFIG_REPORT_EVERY    (10)
+#define TASK_MONITOR_CONFIG_ALARM_WORDS     (16)
+#define TASK_MONITOR_CONFIG_MARGIN_PCT      (25)
+#define TASK_MONITOR_CONFIG_MAX_TASKS       (16)
+
+/********************** typedef **********************************************/
+typedef struct {
+
+	const char * name;
+	uint16_t stack_words;		/* tamano asignado (configMINIMAL_STACK_SIZE si no se registro) */
+	uint16_t min_free_words;	/* marca de agua minima observada */
+	uint16_t recommended_words;
+	bool alarm;
+} task_monitor_entry_t;
+
+/********************** external functions declaration ***********************/
+bool task_monitor_init(void);
+void task_monitor_register(TaskHandle_t task, uint16_t stack_words);
+uint8_t task_monitor_get(task_monitor_entry_t * entries, uint8_t max);
+uint32_t task_monitor_get_alarms(void);
+
+#endif /* INC_TASK_MONITOR_H_ */
@@ -0,0 +1,54 @@
+/*
+ * telemetry.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_TELEMETRY_H_
+#define INC_TELEMETRY_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Telemetria binaria por USART2 (uart_io): cada TELEMETRY_CONFIG_PERIOD_MS una
+ * tarea de baja prioridad manda una trama por tipo de registro. Trama en el
+ * cable: 0x00, COBS(tipo, secuencia, payload, CRC16 LE), 0x00. El 0x00 inicial
+ * separa la trama de cualquier texto que comparta el puerto. Los enteros van en
+ * little endian. El CRC es CRC-16/CCITT-FALSE sobre tipo..payload.
+ * Decodificador: tools/telemetry.py. */
+#define TELEMETRY_CONFIG_ENABLE         (1)
+#define TELEMETRY_CONFIG_PERIOD_MS      (1000)
+#define TELEMETRY_CONFIG_MAX_TASKS      (16)
+#define TELEMETRY_CONFIG_NAME_LEN       (8)		/* nombre de tarea truncado */
+#define TELEMETRY_CONFIG_PRIORITY       (tskIDLE_PRIORITY + 1)
+#define TELEMETRY_CONFIG_STACK_SIZE     (192)
+
+/********************** typedef **********************************************/
+/* Payload de cada tipo (campos en orden):
+ *  SYS:     tick u32, cpu_1s_pm u16 (0xFFFF sin dato), heap_libre u32,
+ *           heap_min u32, ui_depth u8, pq_depth u8, pq_evicted u32,
+ *           ui_rejected u32 x3 (pulso, corto, largo), work_dropped u32,
+ *           work_executed u32, stack_alarms u32, tx_bytes u32,
+ *           frames_failed u32, led_holds_done u32 (encendidos cumplidos
+ *           desde el arranque: el ritmo de vaciado es la diferencia)
+ *  TASKS:   n u8; n x (name[TELEMETRY_CONFIG_NAME_LEN], prio u8, state u8,
+ *           cpu_pm u16, stack_free_words u16)
+ *  LATENCY: core_hz u32, avg_cycles u32, max_cycles u32, buckets u8,
+ *           buckets x u32 (cubeta i = [2^(i-1), 2^i) us)
+ *  PARAMS:  version u32, n u8, n x u32 (orden de param_id_t); solo cuando
+ *           cambia params_version() */
+typedef enum {
+
+	TELEMETRY_SYS = 1,
+	TELEMETRY_TASKS = 2,
+	TELEMETRY_LATENCY = 3,
+	TELEMETRY_PARAMS = 4,
+} telemetry_type_t;
+
+/********************** external functions declaration ***********************/
+bool telemetry_init(void);
+
+#endif /* INC_TELEMETRY_H_ */
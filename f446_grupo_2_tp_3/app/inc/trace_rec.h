@@ -0,0 +1,66 @@
+/*
+ * trace_rec.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_TRACE_REC_H_
+#define INC_TRACE_REC_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Registro de eventos del kernel en un anillo en RAM con marca de tiempo DWT.
+ * Se activa con configAPP_KERNEL_TRACE en FreeRTOSConfig.h, que conecta los
+ * macros trace* del kernel con este modulo. El registro es de tipo instantanea:
+ * se detiene al llenarse y trace_rec_dump() lo vuelca por el logger, una linea
+ * "[TRACE] ..." por registro. En la PC, tools/trace_json.py pasa el log a Chrome
+ * trace JSON (abrir con chrome://tracing o ui.perfetto.dev). */
+#define TRACE_REC_CONFIG_LEN            (128)	/* registros de 16 B */
+#define TRACE_REC_CONFIG_MAX_TASKS      (12)	/* tareas distintas nombradas en el volcado */
+
+/********************** typedef **********************************************/
+typedef enum {
+
+	TRACE_REC_EV_SWITCH_IN,
+	TRACE_REC_EV_SWITCH_OUT,
+	TRACE_REC_EV_QUEUE_SEND,
+	TRACE_REC_EV_QUEUE_RECV,
+	TRACE_REC_EV_BLOCK_SEND,
+	TRACE_REC_EV_BLOCK_RECV,
+	TRACE_REC_EV_BLOCK_NOTIFY,
+	TRACE_REC_EV_DELAY,
+	TRACE_REC_EV_NOTIFY,
+	TRACE_REC_EV_ISR_ENTER,
+	TRACE_REC_EV_ISR_EXIT,
+	TRACE_REC_EV__N,
+} trace_rec_event_t;
+
+typedef struct {
+
+	uint32_t cycles;		/* DWT->CYCCNT */
+	const void * task;		/* tarea en ejecucion al momento del evento */
+	const void * obj;		/* cola, tarea notificada o NULL */
+	uint8_t event;			/* trace_rec_event_t */
+	uint8_t irq;			/* numero de IRQ en eventos de ISR */
+} trace_rec_t;
+
+/********************** external functions declaration ***********************/
+void trace_rec_init(void);
+void trace_rec_start(void);
+void trace_rec_stop(void);
+bool trace_rec_is_full(void);
+uint16_t trace_rec_get(trace_rec_t * records, uint16_t max);
+void trace_rec_dump(void);
+
+/* Hooks llamados desde los macros del kernel y desde los handlers de IRQ. */
+void trace_rec_switch_in(const void * task);
+void trace_rec_switch_out(const void * task);
+void trace_rec_kernel(uint8_t event, const void * obj);
+void trace_rec_isr_enter(uint8_t irq);
+void trace_rec_isr_exit(uint8_t irq);
+
+#endif /* INC_TRACE_REC_H_ */
@@ -0,0 +1,42 @@
+/*
+ * uart_io.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_UART_IO_H_
+#define INC_UART_IO_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cmsis_os.h"
+
+/********************** macros ***********************************************/
+/* USART2 (ST-LINK VCP) por DMA: uart_io_write() toma el mutex del puerto, lanza
+ * la transferencia por DMA1 Stream6 y bloquea a la tarea hasta el fin de
+ * transmision (USART TC), sin una interrupcion por byte. La inicializacion de
+ * la DMA y el NVIC esta aca y no en el codigo de CubeMX, para no tocar el .ioc.
+ * Recepcion: DMA1 Stream5 circular sobre un buffer de UART_IO_CONFIG_RX_DMA_LEN
+ * bytes; en media vuelta, vuelta completa o linea inactiva (IDLE) se copia lo
+ * nuevo a un stream buffer que se lee con uart_io_read(). Un solo lector. */
+#define UART_IO_CONFIG_ENABLE           (1)
+#define UART_IO_IRQ_PRIORITY            (6)		/* >= configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY */
+#define UART_IO_CONFIG_RX_DMA_LEN       (64)
+#define UART_IO_CONFIG_RX_STREAM_LEN    (128)
+
+/********************** external functions declaration ***********************/
+bool uart_io_init(void);
+bool uart_io_write(const uint8_t * data, uint16_t len, TickType_t timeout);
+size_t uart_io_read(uint8_t * data, size_t len, TickType_t timeout);
+uint32_t uart_io_get_tx_bytes(void);
+uint32_t uart_io_get_rx_bytes(void);
+uint32_t uart_io_get_rx_dropped(void);
+void uart_io_dma_tx_irq(void);
+void uart_io_dma_rx_irq(void);
+void uart_io_irq(void);
+
+#endif /* INC_UART_IO_H_ */
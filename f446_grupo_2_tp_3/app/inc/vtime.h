@@ -0,0 +1,35 @@
+/*
+ * vtime.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_VTIME_H_
+#define INC_VTIME_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Tiempo virtual: con configAPP_VIRTUAL_TIME en FreeRTOSConfig.h el idle
+ * tickless no duerme; cuando todas las tareas estan bloqueadas adelanta el
+ * contador de ticks hasta el proximo desbloqueo (vTaskStepTick). Un escenario
+ * de prueba (TESTING_ARRAY_INPUTS_N) corre en milisegundos reales y los
+ * tiempos que informa el kernel son los simulados, exactos al tick. */
+
+/********************** typedef **********************************************/
+typedef struct {
+
+	uint32_t jumps;					/* saltos de tiempo hechos por el idle */
+	uint32_t skipped_ticks;			/* ticks simulados sin esperar */
+	uint32_t virtual_ms;			/* tiempo del kernel (simulado) */
+	uint32_t real_ms;				/* tiempo real, base de la HAL (TIM1) */
+} vtime_stats_t;
+
+/********************** external functions declaration ***********************/
+void vtime_skip(uint32_t expected_ticks);
+void vtime_get_stats(vtime_stats_t * stats);
+
+#endif /* INC_VTIME_H_ */
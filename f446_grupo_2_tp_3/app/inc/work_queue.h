@@ -0,0 +1,54 @@
+/*
+ * work_queue.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef INC_WORK_QUEUE_H_
+#define INC_WORK_QUEUE_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Trabajo diferido: los productores encolan (fn, arg) sin bloquear y un grupo de
+ * tareas trabajadoras lo ejecuta. Una cola MPMC sin locks (LDREX/STREX) por
+ * prioridad; un semaforo contador despierta a los trabajadores. Task1/Task2 de
+ * CubeMX son los trabajadores base; se pueden agregar mas con
+ * WORK_CONFIG_EXTRA_WORKERS. Puede haber productores de menor prioridad que los
+ * trabajadores: si uno queda desalojado con una celda reservada sin publicar, el
+ * trabajador que la encuentra espera un tick en vez de girar. */
+#define WORK_CONFIG_QUEUE_LEN           (8)		/* por prioridad, potencia de 2 */
+#define WORK_CONFIG_PRIORITY            (tskIDLE_PRIORITY + 1)	/* encima de task_ui, que encola */
+#define WORK_CONFIG_EXTRA_WORKERS       (0)
+#define WORK_CONFIG_STACK_SIZE          (128)	/* trabajadores extra */
+
+/********************** typedef **********************************************/
+typedef void (*work_fn_t)(void * arg);
+
+typedef enum {
+
+	WORK_PRIO_HIGH,
+	WORK_PRIO_NORMAL,
+	WORK_PRIO_LOW,
+	WORK_PRIO__N,
+} work_prio_t;
+
+typedef struct {
+
+	uint32_t submitted[WORK_PRIO__N];
+	uint32_t dropped[WORK_PRIO__N];		/* cola llena */
+	uint32_t executed;
+	uint8_t workers;
+} work_stats_t;
+
+/********************** external functions declaration ***********************/
+bool work_init(void);
+bool work_submit(work_fn_t fn, void * arg, work_prio_t prio);
+bool work_submit_from_isr(work_fn_t fn, void * arg, work_prio_t prio, BaseType_t * woken);
+void work_worker_run(void);
+void work_get_stats(work_stats_t * stats);
+
+#endif /* INC_WORK_QUEUE_H_ */
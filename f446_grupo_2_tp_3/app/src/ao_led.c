@@ -16,11 +16,21 @@
 #include "logger.h"
 #include "dwt.h"
 
+#include "app.h"
 #include "ao_led.h"
 #include "priority_queue.h"
+#include "task_monitor.h"
+#include "ao_sched.h"
+#include "scenario.h"
+#include "params.h"
+
+#if 1 == APP_CONFIG_STACKLESS_AO && 0 == AO_LED_CONFIG_PARALLEL
+#error "APP_CONFIG_STACKLESS_AO requiere AO_LED_CONFIG_PARALLEL: el modo secuencial bloquea durante el encendido"
+#endif
 
 /********************** macros and definitions *******************************/
 #define TASK_PERIOD_MS_         (50)
+#define TASK_STACK_SIZE_		(128)
 #define QUEUE_LED_LENGTH_		(10)
 #define QUEUE_LED_ITEM_SIZE_	(sizeof(ao_led_message_t*))
 
@@ -30,11 +40,52 @@ static uint16_t led_pin_[] = {LED_RED_PIN,  LED_GREEN_PIN, LED_BLUE_PIN };
 static const char *colorNames[] = {"RED", "GREEN", "BLUE"};
 static const char *prioNames[] = {"LOW", "MED", "HIGH"};
 static bool led_task_running = false;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION && 0 == APP_CONFIG_STACKLESS_AO
+static StaticTask_t task_led_tcb_;
+static StackType_t task_led_stack_[TASK_STACK_SIZE_];
+#endif
+static uint32_t led_hold_ms = AO_LED_CONFIG_HOLD_MAX_MS;	/* tiempo de encendido en uso. */
+static uint32_t holds_done_;		/* encendidos cumplidos: un pedido desalojado cuenta al terminar */
+
+#if 1 == AO_LED_CONFIG_ADAPTIVE_HOLD
+/* Porcentaje del recorte por backlog que se aplica segun prioridad (LOW, MED, HIGH):
+ * los pedidos de alta prioridad conservan mas tiempo de encendido. */
+static const uint8_t hold_prio_weight_[] = {100, 75, 50};
+#endif
+
+#if 1 == AO_LED_CONFIG_PARALLEL
+typedef struct {
+
+	bool busy;							/* LED encendido con el pedido cur */
+	data_queue_t cur;
+	prio_queue_priority_t cur_prio;
+	TickType_t t_end;					/* tick en que se apaga el LED */
+	bool parked;						/* hay un pedido esperando este carril */
+	data_queue_t next;
+	prio_queue_priority_t next_prio;
+} led_lane_t;
+
+static led_lane_t lanes_[AO_LED_COLOR__N];
+#endif
 
 /********************** internal functions declaration ***********************/
+#if 0 == APP_CONFIG_STACKLESS_AO
 static void task_led(void *argument);
+#else
+static int led_pt_(pt_t * pt);
+#endif
 static void turnOnLed(ao_led_color_t color, TickType_t * t0_led_on);
 static void turnOffLed(ao_led_color_t color);
+static uint32_t hold_time_ms_(prio_queue_priority_t prio);
+#if 1 == AO_LED_CONFIG_PARALLEL
+static void lane_start_(led_lane_t * lane, data_queue_t data, prio_queue_priority_t prio);
+static bool lane_dispatch_(data_queue_t data, prio_queue_priority_t prio);
+static void lanes_expire_(TickType_t now);
+static TickType_t lanes_next_timeout_(TickType_t now);
+static TickType_t led_step_(void);
+#else
+static bool hold_led_(data_queue_t * data, prio_queue_priority_t prio);
+#endif
 
 /********************** internal functions definition ************************/
 static inline void todos_los_led_apagados(void) {
@@ -47,16 +98,246 @@ static inline void todos_los_led_apagados(void) {
 static void turnOnLed(ao_led_color_t color, TickType_t * t0_led_on) {
 
 	HAL_GPIO_WritePin(led_port_[color], led_pin_[color], LED_ON);
+#ifdef TESTING_SIMULATION_BUTTON_INPUTS
+	scenario_on_led(color, true);
+#endif
 	*t0_led_on = xTaskGetTickCount(); /* comenzar a contar tiempo desde led encendido. */
 }
 
 static void turnOffLed(ao_led_color_t color) {
 
 	HAL_GPIO_WritePin(led_port_[color], led_pin_[color], LED_OFF);
+#ifdef TESTING_SIMULATION_BUTTON_INPUTS
+	scenario_on_led(color, false);
+#endif
 }
 
+static uint32_t hold_time_ms_(prio_queue_priority_t prio) {
+
+#if 1 == AO_LED_CONFIG_ADAPTIVE_HOLD
+	/* El recorte crece linealmente con los pedidos pendientes: con la cola llena
+	 * un pedido LOW se mantiene HOLD_MIN, asi el vaciado de la cola queda acotado
+	 * al largo de la cola * HOLD_MIN durante una rafaga. */
+	uint32_t hold_max = param_get(PARAM_LED_HOLD_MS);
+	uint32_t limit = prio_queue_limit();
+	uint32_t backlog = prio_queue_count();
+
+	if(limit < backlog)
+		backlog = limit;
+	uint32_t cut = ((hold_max - AO_LED_CONFIG_HOLD_MIN_MS) * backlog) / limit;
+	cut = (cut * hold_prio_weight_[prio]) / 100;
+	return hold_max - cut;
+#else
+	(void)prio;
+	return param_get(PARAM_LED_HOLD_MS);
+#endif
+}
+
+#if 0 == AO_LED_CONFIG_PARALLEL
+/* Mantiene encendido el LED data->color durante data->hold_ms. Devuelve false si
+ * el pedido fue desalojado por otro de mayor prioridad (lo restante se reencola). */
+static bool hold_led_(data_queue_t * data, prio_queue_priority_t prio) {
+
+	TickType_t t0;
+	TickType_t hold = pdMS_TO_TICKS(data->hold_ms);
+
+	turnOnLed(data->color, &t0);
+
+#if 1 == AO_LED_CONFIG_PREEMPT
+	TickType_t elapsed = 0;
+
+	while(elapsed < hold) {
+
+		prio_queue_priority_t head_prio;
+
+		/* cada insercion en la cola de prioridad despierta a esta tarea: */
+		ulTaskNotifyTake(pdTRUE, hold - elapsed);
+		elapsed = xTaskGetTickCount() - t0;
+
+		if(elapsed < hold && prio_queue_peek_priority(&head_prio) && head_prio > prio) {
+
+			turnOffLed(data->color);
+			data->hold_ms = ((hold - elapsed) * portTICK_PERIOD_MS);
+			if(prio_queue_insert_front(*data, prio))
+				LOGGER_INFO("[LED] %s desalojado, resta %lu ms", colorNames[data->color], (unsigned long)data->hold_ms);
+			else
+				LOGGER_INFO("[LED] %s desalojado, cola llena: se descarta el resto", colorNames[data->color]);
+			return false;
+		}
+	}
+#else
+	vTaskDelayUntil(&t0, hold);
+#endif
+	turnOffLed(data->color);
+	return true;
+}
+#endif
+
 /********************** external functions declaration ***********************/
 
+#if 1 == AO_LED_CONFIG_PARALLEL
+static void lane_start_(led_lane_t * lane, data_queue_t data, prio_queue_priority_t prio) {
+
+	TickType_t t0;
+
+	if(0 == data.hold_ms)
+		data.hold_ms = hold_time_ms_(prio);
+	led_hold_ms = data.hold_ms;
+	LOGGER_INFO("[LED] ON %s (p=%s, hold=%lu ms, cola=%u)", colorNames[data.color], prioNames[prio],
+				(unsigned long)led_hold_ms, prio_queue_count());
+	turnOnLed(data.color, &t0);
+	lane->cur = data;
+	lane->cur_prio = prio;
+	lane->t_end = t0 + pdMS_TO_TICKS(data.hold_ms);
+	lane->busy = true;
+}
+
+/* Ubica un pedido en el carril de su color. Devuelve false si el carril no puede
+ * tomarlo (ocupado y con lugar de espera de igual o mayor prioridad): el pedido
+ * debe volver al frente de la cola y el despacho se detiene para no adelantar
+ * pedidos de menor prioridad. */
+static bool lane_dispatch_(data_queue_t data, prio_queue_priority_t prio) {
+
+	led_lane_t * lane = &lanes_[data.color];
+
+	if(!lane->busy) {
+
+		lane_start_(lane, data, prio);
+		return true;
+	}
+
+#if 1 == AO_LED_CONFIG_PREEMPT
+	if(prio > lane->cur_prio) {
+
+		/* desalojo: lo que resta del pedido en curso pasa al lugar de espera y lo
+		 * que estaba esperando (de menor o igual prioridad) vuelve a la cola. */
+		int32_t left = (int32_t)(lane->t_end - xTaskGetTickCount());
+		TickType_t remaining = (0 < left) ? (TickType_t)left : 1;
+
+		turnOffLed(data.color);
+
+		if(lane->parked)
+			prio_queue_insert_front(lane->next, lane->next_prio);
+		lane->next = lane->cur;
+		lane->next.hold_ms = remaining * portTICK_PERIOD_MS;
+		lane->next_prio = lane->cur_prio;
+		lane->parked = true;
+		LOGGER_INFO("[LED] %s desalojado, resta %lu ms", colorNames[data.color], (unsigned long)lane->next.hold_ms);
+		lane_start_(lane, data, prio);
+		return true;
+	}
+#endif
+
+	if(!lane->parked) {
+
+		lane->next = data;
+		lane->next_prio = prio;
+		lane->parked = true;
+		return true;
+	}
+
+	if(prio > lane->next_prio) {
+
+		prio_queue_insert_front(lane->next, lane->next_prio);
+		lane->next = data;
+		lane->next_prio = prio;
+		return true;
+	}
+	return false;
+}
+
+static void lanes_expire_(TickType_t now) {
+
+	for(uint8_t color = 0; color < AO_LED_COLOR__N; color++) {
+
+		led_lane_t * lane = &lanes_[color];
+
+		/* comparacion con signo para tolerar el desborde del contador de ticks */
+		if(lane->busy && (int32_t)(now - lane->t_end) >= 0) {
+
+			turnOffLed(color);
+			lane->busy = false;
+			holds_done_++;
+			LOGGER_INFO("[LED] OFF %s", colorNames[color]);
+
+			if(lane->parked) {
+
+				lane->parked = false;
+				lane_start_(lane, lane->next, lane->next_prio);
+			}
+		}
+	}
+}
+
+static TickType_t lanes_next_timeout_(TickType_t now) {
+
+	TickType_t timeout = portMAX_DELAY;
+
+	for(uint8_t color = 0; color < AO_LED_COLOR__N; color++) {
+
+		if(lanes_[color].busy) {
+
+			int32_t left = (int32_t)(lanes_[color].t_end - now);
+
+			if(0 >= left)
+				return 0;
+
+			if((TickType_t)left < timeout)
+				timeout = (TickType_t)left;
+		}
+	}
+	return timeout;
+}
+
+/* Apaga lo vencido, despacha lo que se pueda y devuelve cuanto se puede esperar
+ * hasta el proximo apagado. Comun a la tarea y al protothread. */
+static TickType_t led_step_(void) {
+
+	prio_queue_priority_t prio;
+	data_queue_t data;
+
+	lanes_expire_(xTaskGetTickCount());
+
+	/* Despachar en orden de prioridad mientras los carriles puedan tomar pedidos: */
+	while(prio_queue_extract(&data, &prio, 0)) {
+
+		if(AO_LED_MESSAGE_ON != data.action)
+			continue;
+
+		if(!lane_dispatch_(data, prio)) {
+
+			prio_queue_insert_front(data, prio);
+			break;
+		}
+	}
+	return lanes_next_timeout_(xTaskGetTickCount());
+}
+
+#if 0 == APP_CONFIG_STACKLESS_AO
+static void task_led(void *argument) {
+
+	LOGGER_INFO("[LED] tarea iniciada");
+
+	/* Dormir hasta el proximo apagado o hasta que entre un pedido nuevo: */
+	while(true)
+		ulTaskNotifyTake(pdTRUE, led_step_());
+}
+#else
+static int led_pt_(pt_t * pt) {
+
+	static TickType_t timeout;
+
+	PT_BEGIN(pt);
+
+	while(true) {
+
+		timeout = led_step_();
+		PT_WAIT_EVENT(pt, timeout);		/* insercion en la cola o proximo apagado */
+	}
+	PT_END(pt);
+}
+#endif
+#else
 static void task_led(void *argument) {
 
 	LOGGER_INFO("[LED] tarea iniciada");
@@ -72,25 +353,53 @@ static void task_led(void *argument) {
 
 			if(AO_LED_MESSAGE_ON == data.action) {
 
-				TickType_t xLastLedOnTime;
-				/* Encender por 5 segundos el LED de prioridad p: */
-				LOGGER_INFO("[LED] ON %s (p=%s)", colorNames[data.color], prioNames[prio]);
-				turnOnLed(data.color, &xLastLedOnTime);
-				vTaskDelayUntil(&xLastLedOnTime, pdMS_TO_TICKS(5000));
-				turnOffLed(data.color);
-				LOGGER_INFO("[LED] OFF %s", colorNames[data.color]);
+				/* Encender el LED de prioridad p por el tiempo que corresponda al backlog,
+				 * o por lo que le restaba si es un pedido desalojado que se reanuda: */
+				if(0 == data.hold_ms)
+					data.hold_ms = hold_time_ms_(prio);
+				led_hold_ms = data.hold_ms;
+				LOGGER_INFO("[LED] ON %s (p=%s, hold=%lu ms, cola=%u)", colorNames[data.color], prioNames[prio],
+							(unsigned long)led_hold_ms, prio_queue_count());
+
+				if(hold_led_(&data, prio)) {
+
+					holds_done_++;
+					LOGGER_INFO("[LED] OFF %s", colorNames[data.color]);
+				}
 			}
 		}
 	}
 }
+#endif
 
 bool ao_led_init() {
 
 	if(led_task_running) /* si la tarea ya ha sido creada... */
 		return true;
 
-	if(pdPASS == xTaskCreate(task_led, "task_led", 128, NULL, tskIDLE_PRIORITY, NULL)) {
+	TaskHandle_t h_task_led = NULL;
+
+#if 1 == APP_CONFIG_STACKLESS_AO
+	/* el consumidor de la cola pasa a ser task_ao, que corre el protothread */
+	if(ao_sched_add(led_pt_))
+		h_task_led = ao_sched_handle();
+#elif 1 == APP_CONFIG_STATIC_ALLOCATION
+	h_task_led = xTaskCreateStatic(task_led, "task_led", TASK_STACK_SIZE_, NULL, tskIDLE_PRIORITY,
+								   task_led_stack_, &task_led_tcb_);
+#else
+	xTaskCreate(task_led, "task_led", TASK_STACK_SIZE_, NULL, tskIDLE_PRIORITY, &h_task_led);
+#endif
+
+	if(NULL != h_task_led) {
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION && 0 == APP_CONFIG_STACKLESS_AO
+		app_static_report("task_led", sizeof(task_led_tcb_) + sizeof(task_led_stack_));
+#endif
 
+		prio_queue_register_consumer(h_task_led);	/* task_led es el unico consumidor de la cola */
+#if 0 == APP_CONFIG_STACKLESS_AO
+		task_monitor_register(h_task_led, TASK_STACK_SIZE_);
+#endif
 		todos_los_led_apagados();
 		led_task_running = true;
 		LOGGER_INFO("[LED] tarea creada");
@@ -100,4 +409,15 @@ bool ao_led_init() {
 	return false;
 }
 
+uint32_t ao_led_get_hold_ms(void) {
+
+	return led_hold_ms;
+}
+
+/* Total desde el arranque; el ritmo de vaciado sale de la diferencia entre dos lecturas. */
+uint32_t ao_led_get_holds_done(void) {
+
+	return holds_done_;
+}
+
 /********************** end of file ******************************************/
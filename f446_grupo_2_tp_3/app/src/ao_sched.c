@@ -0,0 +1,165 @@
+/*
+ * ao_sched.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+
+#include "app.h"
+#include "task_monitor.h"
+#include "ao_sched.h"
+
+/********************** macros and definitions *******************************/
+#define TASK_STACK_SIZE_        (AO_SCHED_CONFIG_STACK_SIZE)
+
+typedef struct {
+
+	ao_sched_fn_t fn;
+	pt_t pt;
+	bool ended;
+} ao_entry_t;
+
+/********************** internal data definition *****************************/
+static ao_entry_t entries_[AO_SCHED_CONFIG_MAX_AO];
+static uint8_t entries_n_;
+static TaskHandle_t h_task_ao_;
+static uint32_t epoch_;					/* cambia en cada vuelta disparada por notificacion */
+static uint32_t passes_;
+static uint32_t pass_cycles_max_;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static StaticTask_t task_ao_tcb_;
+static StackType_t task_ao_stack_[TASK_STACK_SIZE_];
+#endif
+
+/********************** internal functions declaration ***********************/
+static void task_ao(void *argument);
+static TickType_t run_all_(void);
+
+/********************** internal functions definition ************************/
+/* Corre una vez cada protothread y devuelve cuanto se puede dormir. */
+static TickType_t run_all_(void) {
+
+	TickType_t timeout = portMAX_DELAY;
+
+	for(uint8_t i = 0; i < entries_n_; i++) {
+
+		ao_entry_t * e = &entries_[i];
+
+		if(e->ended)
+			continue;
+
+		if(PT_ENDED == e->fn(&e->pt)) {
+
+			e->ended = true;
+			continue;
+		}
+
+		if(e->pt.armed) {
+
+			int32_t left = (int32_t)(e->pt.wake - xTaskGetTickCount());
+
+			if(0 >= left)
+				timeout = 0;
+			else if((TickType_t)left < timeout)
+				timeout = (TickType_t)left;
+		}
+	}
+	return timeout;
+}
+
+static void task_ao(void *argument) {
+
+	LOGGER_INFO("[AO] planificador con %u AO", entries_n_);
+
+	while(true) {
+
+		uint32_t t0 = cycle_counter_get();
+		TickType_t timeout = run_all_();
+		uint32_t cycles = cycle_counter_get() - t0;
+
+		passes_++;
+
+		if(cycles > pass_cycles_max_)
+			pass_cycles_max_ = cycles;
+
+		if(0 != ulTaskNotifyTake(pdTRUE, timeout))
+			epoch_++;
+	}
+}
+
+/********************** external functions definition ************************/
+bool ao_sched_init(void) {
+
+	if(NULL != h_task_ao_)
+		return true;
+
+	/* por encima de task_ao_ui/task_led en modo tarea: hace de los tres */
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	h_task_ao_ = xTaskCreateStatic(task_ao, "task_ao", TASK_STACK_SIZE_, NULL, tskIDLE_PRIORITY + 2,
+								   task_ao_stack_, &task_ao_tcb_);
+#else
+	xTaskCreate(task_ao, "task_ao", TASK_STACK_SIZE_, NULL, tskIDLE_PRIORITY + 2, &h_task_ao_);
+#endif
+
+	if(NULL == h_task_ao_) {
+
+		LOGGER_INFO("[AO] error en ao_sched_init().");
+		return false;
+	}
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("task_ao", sizeof(task_ao_tcb_) + sizeof(task_ao_stack_) + sizeof(entries_));
+#endif
+	task_monitor_register(h_task_ao_, TASK_STACK_SIZE_);
+	return true;
+}
+
+/* Registrar antes de arrancar el kernel: la tabla no se protege. */
+bool ao_sched_add(ao_sched_fn_t fn) {
+
+	if(NULL == fn || AO_SCHED_CONFIG_MAX_AO <= entries_n_)
+		return false;
+
+	entries_[entries_n_].fn = fn;
+	PT_INIT(&entries_[entries_n_].pt);
+	entries_[entries_n_].ended = false;
+	entries_n_++;
+	return true;
+}
+
+void ao_sched_signal(void) {
+
+	if(NULL != h_task_ao_)
+		xTaskNotifyGive(h_task_ao_);
+}
+
+uint32_t ao_sched_epoch(void) {
+
+	return epoch_;
+}
+
+TaskHandle_t ao_sched_handle(void) {
+
+	return h_task_ao_;
+}
+
+void ao_sched_get_stats(ao_sched_stats_t * stats) {
+
+	stats->passes = passes_;
+	stats->events = epoch_;
+	stats->pass_cycles_max = pass_cycles_max_;
+	stats->ram_bytes = (uint16_t)(sizeof(StaticTask_t) + TASK_STACK_SIZE_ * sizeof(StackType_t) +
+								  entries_n_ * sizeof(ao_entry_t));
+	stats->ao_n = entries_n_;
+}
+
+/********************** end of file ******************************************/
@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "main.h"
 #include "cmsis_os.h"
@@ -14,13 +15,34 @@
 #include "logger.h"
 #include "dwt.h"
 
+#include "app.h"
 #include "ao_ui.h"
 #include "priority_queue.h"
+#include "task_monitor.h"
+#include "work_queue.h"
+#include "ao_sched.h"
+#include "event_rec.h"
+#include "params.h"
 
 /********************** macros and definitions *******************************/
-#define TASK_PERIOD_MS_          (50)
-#define QUEUE_LENGTH_            (10)
+#define QUEUE_LENGTH_            (AO_UI_QUEUE_LENGTH)
 #define QUEUE_ITEM_SIZE_         (sizeof(msg_event_t*))
+#define TASK_STACK_SIZE_         (128)
+
+#define RATE_TOKEN_SCALE_        (1000)	/* tokens en milesimas: 1 evento = 1000 */
+
+typedef struct {
+
+	uint16_t rate_per_s;	/* eventos por segundo sostenidos */
+	uint16_t burst;			/* eventos seguidos admitidos con el balde lleno */
+} rate_cfg_t;
+
+typedef struct {
+
+	uint32_t tokens;
+	TickType_t last;
+	uint32_t rejected;
+} rate_bucket_t;
 
 typedef enum {
 
@@ -34,14 +56,188 @@ typedef enum {
 /********************** internal data definition *****************************/
 static bool ui_running;
 static QueueHandle_t hqueue;
+static uint32_t cycles_reported_n;	/* inserciones ya informadas en el log de ciclos */
+/* Latencia de despacho: desde ao_ui_send_event() con la cola vacia hasta que el
+ * AO toma el evento. Sirve para comparar el modo tarea con el modo sin stack. */
+static uint32_t latency_t0_;
+static bool latency_armed_;
+static uint32_t latency_n_;
+static uint32_t latency_total_;
+static uint32_t latency_max_;
+static uint32_t latency_hist_[AO_UI_LATENCY_BUCKETS];
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+#if 0 == APP_CONFIG_STACKLESS_AO
+static StaticTask_t task_ui_tcb_;
+static StackType_t task_ui_stack_[TASK_STACK_SIZE_];
+#endif
+static StaticQueue_t queue_ui_ctrl_;
+static uint8_t queue_ui_storage_[QUEUE_LENGTH_ * QUEUE_ITEM_SIZE_];
+#endif
+
+/* Un boton real no supera ~4 eventos/s (pulso minimo de 200 ms + 50 ms suelto). */
+static const rate_cfg_t rate_cfg_[MSG_EVENT__N] = {
+
+	[MSG_EVENT_BUTTON_PULSE] = {4, 8},
+	[MSG_EVENT_BUTTON_SHORT] = {2, 6},
+	[MSG_EVENT_BUTTON_LONG]  = {1, 4},
+};
+static rate_bucket_t rate_bucket_[MSG_EVENT__N];
 
 /********************** internal functions declaration ***********************/
+#if 0 == APP_CONFIG_STACKLESS_AO
 static void task_ui(void *argument);
+#else
+static int ui_pt_(pt_t * pt);
+#endif
+static void ui_handle_event_(msg_event_t msg);
+static bool send_(msg_event_t msg, event_rec_src_t src);
+static void log_queue_cycles_(void * arg);
+static void rate_limit_init_(void);
+#if 1 == AO_UI_CONFIG_RATE_LIMIT
+static bool rate_limit_take_(msg_event_t msg);
+#endif
 
 /********************** internal functions definition ************************/
-static void task_ui(void *argument) {
+/* Informa los ciclos DWT de la cola de prioridad cuando hubo actividad nueva.
+ * Corre como trabajo diferido: el formateo no ocupa a task_ui. */
+static void log_queue_cycles_(void * arg) {
+
+	prio_queue_cycles_t cycles;
+
+	(void)arg;
+
+	prio_queue_get_cycles(&cycles);
+
+	if(cycles.insert_n == cycles_reported_n)
+		return;
+	cycles_reported_n = cycles.insert_n;
+	LOGGER_INFO("[UI] cola ins %lu/%lu ext %lu/%lu cic", (unsigned long)cycles.insert_cycles_avg,
+				(unsigned long)cycles.insert_cycles_max, (unsigned long)cycles.extract_cycles_avg,
+				(unsigned long)cycles.extract_cycles_max);
+
+	uint32_t avg, max;
+
+	ao_ui_get_latency(&avg, &max);
+	LOGGER_INFO("[UI] latencia de despacho %lu/%lu cic", (unsigned long)avg, (unsigned long)max);
+}
+
+static void rate_limit_init_(void) {
+
+	TickType_t now = xTaskGetTickCount();
+
+	for(uint8_t i = 0; i < MSG_EVENT__N; i++) {
+
+		rate_bucket_[i].tokens = rate_cfg_[i].burst * RATE_TOKEN_SCALE_;
+		rate_bucket_[i].last = now;
+		rate_bucket_[i].rejected = 0;
+	}
+}
+
+#if 1 == AO_UI_CONFIG_RATE_LIMIT
+/* O(1): los baldes los escriben task_button y la consola ("ev"), asi que la
+ * lectura-modificacion-escritura va en una seccion critica corta; los
+ * contadores se leen con accesos atomicos de 32 bits. */
+static bool rate_limit_take_(msg_event_t msg) {
+
+	rate_bucket_t * b = &rate_bucket_[msg];
+	const rate_cfg_t * cfg = &rate_cfg_[msg];
+	uint32_t cap = cfg->burst * RATE_TOKEN_SCALE_;
+	TickType_t now;
+	uint32_t elapsed_ms;
+	bool ok = false;
+
+	taskENTER_CRITICAL();
+	now = xTaskGetTickCount();
+	elapsed_ms = (now - b->last) * portTICK_PERIOD_MS;
+	b->last = now;
+
+	/* la recarga es rate milesimas de token por ms; tras mucho tiempo quieto se
+	 * llena directamente para no desbordar la multiplicacion. */
+	if(0 != cfg->rate_per_s) {
+
+		if(elapsed_ms >= (cap / cfg->rate_per_s))
+			b->tokens = cap;
+		else
+			b->tokens += elapsed_ms * cfg->rate_per_s;
+
+		if(b->tokens > cap)
+			b->tokens = cap;
+	}
+
+	if(RATE_TOKEN_SCALE_ <= b->tokens) {
+
+		b->tokens -= RATE_TOKEN_SCALE_;
+		ok = true;
+	} else {
+
+		b->rejected++;
+	}
+	taskEXIT_CRITICAL();
+	return ok;
+}
+#endif
+
+/* Cubeta del histograma de latencia: log2 de los microsegundos. */
+static uint8_t latency_bucket_(uint32_t cycles) {
 
-	prio_queue_init();
+	uint32_t us = cycles / cycles_per_us;
+	uint8_t bucket = (0 == us) ? 0 : (uint8_t)(32 - __builtin_clz(us));
+
+	return (AO_UI_LATENCY_BUCKETS > bucket) ? bucket : AO_UI_LATENCY_BUCKETS - 1;
+}
+
+/* Atiende un evento de boton: comun a la tarea y al protothread. */
+static void ui_handle_event_(msg_event_t msg) {
+
+	data_queue_t ao_led_msg;
+	ao_led_msg.action = AO_LED_MESSAGE_ON;
+	ao_led_msg.hold_ms = 0;
+
+	taskENTER_CRITICAL();
+	if(latency_armed_) {
+
+		uint32_t cycles = cycle_counter_get() - latency_t0_;
+
+		latency_armed_ = false;
+		latency_n_++;
+		latency_total_ += cycles;
+
+		if(cycles > latency_max_)
+			latency_max_ = cycles;
+		latency_hist_[latency_bucket_(cycles)]++;
+	}
+	taskEXIT_CRITICAL();
+
+	switch(msg) {
+
+		case MSG_EVENT_BUTTON_PULSE:
+			ao_led_msg.color = AO_LED_COLOR_RED;
+			if(prio_queue_insert(ao_led_msg, PRIO_QUEUE_PRIORITY_HIGH)) {
+
+				LOGGER_INFO("[UI] Insert High");
+			}
+			break;
+		case MSG_EVENT_BUTTON_SHORT:
+			ao_led_msg.color = AO_LED_COLOR_GREEN;
+			if(prio_queue_insert(ao_led_msg, PRIO_QUEUE_PRIORITY_MEDIUM)) {
+
+				LOGGER_INFO("[UI] Insert Medium");
+			}
+			break;
+		case MSG_EVENT_BUTTON_LONG:
+			ao_led_msg.color = AO_LED_COLOR_BLUE;
+			if(prio_queue_insert(ao_led_msg, PRIO_QUEUE_PRIORITY_LOW)) {
+
+				LOGGER_INFO("[UI] Insert Low");
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+#if 0 == APP_CONFIG_STACKLESS_AO
+static void task_ui(void *argument) {
 
 	while(true) {
 
@@ -49,32 +245,92 @@ static void task_ui(void *argument) {
 
 		if(pdPASS == xQueueReceive(hqueue, &msg, 1000)) {
 
-			data_queue_t ao_led_msg;
-			ao_led_msg.action = AO_LED_MESSAGE_ON;
-
-			switch(msg) {
-
-				case MSG_EVENT_BUTTON_PULSE:
-					ao_led_msg.color = AO_LED_COLOR_RED;
-					if(prio_queue_insert(ao_led_msg, PRIO_QUEUE_PRIORITY_HIGH))
-						LOGGER_INFO("[UI] Insert High");
-					break;
-				case MSG_EVENT_BUTTON_SHORT:
-					ao_led_msg.color = AO_LED_COLOR_GREEN;
-					if(prio_queue_insert(ao_led_msg, PRIO_QUEUE_PRIORITY_MEDIUM))
-						LOGGER_INFO("[UI] Insert Medium");
-					break;
-				case MSG_EVENT_BUTTON_LONG:
-					ao_led_msg.color = AO_LED_COLOR_BLUE;
-					if(prio_queue_insert(ao_led_msg, PRIO_QUEUE_PRIORITY_LOW))
-						LOGGER_INFO("[UI] Insert Low");
-					break;
-				default:
-					break;
-			}
+			ui_handle_event_(msg);
+		} else {
+
+			work_submit(log_queue_cycles_, NULL, WORK_PRIO_LOW);	/* sin eventos durante 1 s */
+		}
+		vTaskDelay((TickType_t)(param_get(PARAM_UI_PERIOD_MS) / portTICK_PERIOD_MS));
+	}
+}
+#else
+/* Misma logica que task_ui: un evento cada PARAM_UI_PERIOD_MS y, tras 1 s sin
+ * eventos, el log de ciclos. Las variables que cruzan una espera son static. */
+static int ui_pt_(pt_t * pt) {
+
+	static msg_event_t msg;
+	static TickType_t last_activity;
+
+	PT_BEGIN(pt);
+	last_activity = xTaskGetTickCount();
+
+	while(true) {
+
+		if(pdPASS == xQueueReceive(hqueue, &msg, 0)) {
+
+			ui_handle_event_(msg);
+			last_activity = xTaskGetTickCount();
+			PT_DELAY(pt, pdMS_TO_TICKS(param_get(PARAM_UI_PERIOD_MS)));
+			continue;
+		}
+
+		if(pdMS_TO_TICKS(1000) <= xTaskGetTickCount() - last_activity) {
+
+			work_submit(log_queue_cycles_, NULL, WORK_PRIO_LOW);	/* sin eventos durante 1 s */
+			last_activity = xTaskGetTickCount();
 		}
-		vTaskDelay((TickType_t)(TASK_PERIOD_MS_ / portTICK_PERIOD_MS));
+		PT_WAIT_EVENT(pt, pdMS_TO_TICKS(1000) - (xTaskGetTickCount() - last_activity));
 	}
+	PT_END(pt);
+}
+#endif
+
+/* El origen solo se usa en el grabador de eventos. */
+static bool send_(msg_event_t msg, event_rec_src_t src) {
+
+	(void)src;
+
+	if(MSG_EVENT__N <= msg || NULL == hqueue)
+		return false;
+
+#if 1 == AO_UI_CONFIG_RATE_LIMIT
+	if(!rate_limit_take_(msg)) {
+
+#if 1 == EVENT_REC_CONFIG_ENABLE
+		event_rec_on_send(msg, EVENT_REC_RATE_LIMITED, uxQueueMessagesWaiting(hqueue), src);
+#endif
+		return false;
+	}
+#endif
+
+	taskENTER_CRITICAL();
+	if(!latency_armed_ && 0 == uxQueueMessagesWaiting(hqueue)) {
+
+		latency_t0_ = cycle_counter_get();
+		latency_armed_ = true;
+	}
+	taskEXIT_CRITICAL();
+
+	BaseType_t status = xQueueSend(hqueue, &msg, 0);
+	bool overflow = (pdPASS != status);
+
+	while(pdPASS != status) {
+
+		LOGGER_INFO("[UI] Cola llena: descartando evento antiguo.");
+		msg_event_t aux;
+		xQueueReceive(hqueue, &aux, 0);
+		status = xQueueSend(hqueue, &msg, 0);
+	}
+#if 1 == EVENT_REC_CONFIG_ENABLE
+	event_rec_on_send(msg, overflow ? EVENT_REC_OVERFLOW : EVENT_REC_OK, uxQueueMessagesWaiting(hqueue), src);
+#else
+	(void)overflow;
+#endif
+#if 1 == APP_CONFIG_STACKLESS_AO
+	ao_sched_signal();
+#endif
+	LOGGER_INFO("[UI] Evento enviado: %d", msg);
+	return (status == pdPASS);
 }
 
 /********************** external functions definition ************************/
@@ -84,12 +340,31 @@ bool ao_ui_init(void) {
 	// agrego logica para que se cree la tarea solo si no hay una corriendo
 	if(!ui_running) {
 
-		hqueue = xQueueCreate(QUEUE_LENGTH_, QUEUE_ITEM_SIZE_);
+		/* el almacenamiento es de QUEUE_LENGTH_: el parametro solo puede acortar la cola */
+		UBaseType_t length = param_get(PARAM_UI_QUEUE_LEN);
+
+		if(0 == length || QUEUE_LENGTH_ < length)
+			length = QUEUE_LENGTH_;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+		hqueue = xQueueCreateStatic(length, QUEUE_ITEM_SIZE_, queue_ui_storage_, &queue_ui_ctrl_);
+#else
+		hqueue = xQueueCreate(length, QUEUE_ITEM_SIZE_);
+#endif
+		rate_limit_init_();
 
 		if(NULL != hqueue) {
 
 			BaseType_t status;
-			status = xTaskCreate(task_ui, "task_ao_ui", 128, NULL, tskIDLE_PRIORITY, NULL);
+			TaskHandle_t h_task_ui = NULL;
+#if 1 == APP_CONFIG_STACKLESS_AO
+			status = ao_sched_add(ui_pt_) ? pdPASS : pdFAIL;
+#elif 1 == APP_CONFIG_STATIC_ALLOCATION
+			h_task_ui = xTaskCreateStatic(task_ui, "task_ao_ui", TASK_STACK_SIZE_, NULL, tskIDLE_PRIORITY,
+										  task_ui_stack_, &task_ui_tcb_);
+			status = (NULL != h_task_ui) ? pdPASS : pdFAIL;
+#else
+			status = xTaskCreate(task_ui, "task_ao_ui", TASK_STACK_SIZE_, NULL, tskIDLE_PRIORITY, &h_task_ui);
+#endif
 
 			if(pdPASS != status) {  // si falla alocacion de mem para la tarea, elimino la queue tambien
 
@@ -99,6 +374,14 @@ bool ao_ui_init(void) {
 
 				init_status = true;
 				ui_running = true;
+				vQueueAddToRegistry(hqueue, "queue_ui");	/* nombre en trazas y depurador */
+				task_monitor_register(h_task_ui, TASK_STACK_SIZE_);
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+				app_static_report("queue_ui", sizeof(queue_ui_ctrl_) + sizeof(queue_ui_storage_));
+#if 0 == APP_CONFIG_STACKLESS_AO
+				app_static_report("task_ui", sizeof(task_ui_tcb_) + sizeof(task_ui_stack_));
+#endif
+#endif
 			}
 		}
 	}
@@ -115,17 +398,50 @@ bool ao_ui_init(void) {
 
 bool ao_ui_send_event(msg_event_t msg) {
 
-	BaseType_t status = xQueueSend(hqueue, &msg, 0);
+	return send_(msg, EVENT_REC_SRC_BUTTON);
+}
 
-	while(pdPASS != status) {
+bool ao_ui_send_console_event(msg_event_t msg) {
 
-		LOGGER_INFO("[UI] Cola llena: descartando evento antiguo.");
-		msg_event_t aux;
-		xQueueReceive(hqueue, &aux, 0);
-		status = xQueueSend(hqueue, &msg, 0);
-	}
-	LOGGER_INFO("[UI] Evento enviado: %d", msg);
-	return (status == pdPASS);
+	return send_(msg, EVENT_REC_SRC_CONSOLE);
+}
+
+uint32_t ao_ui_get_rejected(msg_event_t msg) {
+
+	return (MSG_EVENT__N > msg) ? rate_bucket_[msg].rejected : 0;
+}
+
+void ao_ui_get_latency(uint32_t * avg_cycles, uint32_t * max_cycles) {
+
+	taskENTER_CRITICAL();
+	*avg_cycles = (0 == latency_n_) ? 0 : latency_total_ / latency_n_;
+	*max_cycles = latency_max_;
+	taskEXIT_CRITICAL();
+}
+
+void ao_ui_get_latency_hist(uint32_t hist[AO_UI_LATENCY_BUCKETS]) {
+
+	taskENTER_CRITICAL();
+	memcpy(hist, latency_hist_, sizeof(latency_hist_));
+	taskEXIT_CRITICAL();
+}
+
+uint8_t ao_ui_get_queue_depth(void) {
+
+	return (NULL == hqueue) ? 0 : (uint8_t)uxQueueMessagesWaiting(hqueue);
+}
+
+/* Pone en cero rechazos y latencias; no toca el estado de los limitadores. */
+void ao_ui_reset_stats(void) {
+
+	taskENTER_CRITICAL();
+	for(uint8_t i = 0; i < MSG_EVENT__N; i++)
+		rate_bucket_[i].rejected = 0;
+	latency_n_ = 0;
+	latency_total_ = 0;
+	latency_max_ = 0;
+	memset(latency_hist_, 0, sizeof(latency_hist_));
+	taskEXIT_CRITICAL();
 }
 
 /********************** end of file ******************************************/
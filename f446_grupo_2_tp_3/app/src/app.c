@@ -41,20 +41,102 @@
 
 #include "app.h"
 #include "task_button.h"
+#include "priority_queue.h"
+#include "priority_queue_test.h"
+#include "mem_pool.h"
+#include "trace_rec.h"
+#include "work_queue.h"
+#include "ao_sched.h"
+#include "task_monitor.h"
+#include "stress_test.h"
+#include "ipc_bench.h"
+#include "telemetry.h"
+#include "console.h"
+#include "params.h"
+#include "flash_log.h"
+
+/********************** macros and definitions *******************************/
+#define TASK_BUTTON_STACK_SIZE_     (128)
+
+/********************** internal data definition *****************************/
+static size_t static_total_;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION && 0 == APP_CONFIG_STACKLESS_AO && 0 == STRESS_TEST_CONFIG_ENABLE && \
+	0 == IPC_BENCH_CONFIG_ENABLE
+static StaticTask_t task_button_tcb_;
+static StackType_t task_button_stack_[TASK_BUTTON_STACK_SIZE_];
+#endif
 
 /********************** external functions definition ************************/
+void app_static_report(const char * name, size_t bytes) {
+
+	static_total_ += bytes;
+	LOGGER_INFO("[APP] %s: %u B estaticos", name, (unsigned)bytes);
+}
+
 void app_init(void) {
 
+#if 1 == MEM_POOL_CONFIG_ENABLE
+	mem_pool_init();		/* antes que cualquier modulo que tome bloques */
+	app_static_report("mem_pool", mem_pool_static_size());
+#endif
+	params_init();			/* antes que los modulos que leen parametros al iniciar */
+	work_init();			/* Task1/Task2 ya creadas: arrancan como trabajadores */
+	prio_queue_init();		/* antes de crear las tareas que la usan */
+#if 1 == PRIO_QUEUE_CONFIG_SELFTEST
+	prio_queue_selftest(PRIO_QUEUE_TEST_SEED, PRIO_QUEUE_TEST_EPISODES);	/* antes de registrar al consumidor (ao_led_init) */
+#endif
+#if 1 == APP_CONFIG_STACKLESS_AO
+	ao_sched_init();		/* task_ao: antes de registrar los protothreads */
+#endif
+#if 1 == STRESS_TEST_CONFIG_ENABLE
+	stress_test_init();		/* reemplaza a AO LED, AO UI y task_button */
+#elif 1 == IPC_BENCH_CONFIG_ENABLE
+	ipc_bench_init();		/* idem */
+#else
 	ao_led_init();
 	ao_ui_init();
 
+#if 1 == APP_CONFIG_STACKLESS_AO
+	if(!ao_sched_add(task_button_pt))
+		while(1);
+#else
+	TaskHandle_t h_task_button = NULL;
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	h_task_button = xTaskCreateStatic(task_button, "task_button", TASK_BUTTON_STACK_SIZE_, NULL, tskIDLE_PRIORITY + 2,
+									  task_button_stack_, &task_button_tcb_);
+
+	if(NULL == h_task_button)
+		while(1);
+	app_static_report("task_button", sizeof(task_button_tcb_) + sizeof(task_button_stack_));
+#else
 	BaseType_t status;
-	status = xTaskCreate(task_button, "task_button", 128, NULL, tskIDLE_PRIORITY + 2, NULL);
+	status = xTaskCreate(task_button, "task_button", TASK_BUTTON_STACK_SIZE_, NULL, tskIDLE_PRIORITY + 2, &h_task_button);
 
 	if(pdPASS != status)
 		while(1);
+#endif
+	task_monitor_register(h_task_button, TASK_BUTTON_STACK_SIZE_);
+#endif
+#endif /* STRESS_TEST_CONFIG_ENABLE, IPC_BENCH_CONFIG_ENABLE */
+#if 1 == TASK_MONITOR_CONFIG_ENABLE
+	task_monitor_init();
+#endif
+#if 1 == TELEMETRY_CONFIG_ENABLE
+	telemetry_init();		/* USART2 por DMA; el decodificador esta en tools/ */
+#endif
+#if 1 == CONSOLE_CONFIG_ENABLE
+	console_init();			/* comandos por USART2 (help) */
+#endif
+#if 1 == FLASH_LOG_CONFIG_ENABLE
+	flash_log_init();		/* metricas y fallas en flash (sectores 6 y 7) */
+#endif
+	LOGGER_INFO("[APP] total estatico %u B, heap libre %u B", (unsigned)static_total_, (unsigned)xPortGetFreeHeapSize());
 	LOGGER_INFO("app init");
 	cycle_counter_init();
+#if (1 == configAPP_KERNEL_TRACE)
+	trace_rec_init();		/* usa CYCCNT: despues de cycle_counter_init() */
+#endif
 }
 
 /********************** end of file ******************************************/
@@ -0,0 +1,461 @@
+/*
+ * console.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+
+#include "app.h"
+#include "ao_ui.h"
+#include "ao_led.h"
+#include "priority_queue.h"
+#include "work_queue.h"
+#include "task_monitor.h"
+#include "uart_io.h"
+#include "params.h"
+#include "flash_log.h"
+#include "event_rec.h"
+#include "console.h"
+
+#if 1 == CONSOLE_CONFIG_ENABLE
+
+/********************** macros and definitions *******************************/
+#define REPLY_LEN_              (96)
+#define TX_TIMEOUT_             (pdMS_TO_TICKS(100))
+#define LOG_DEFAULT_N_          (20)
+#define LOG_SYNC_TIMEOUT_       (pdMS_TO_TICKS(3000))	/* puede incluir borrar un sector */
+
+typedef void (*cmd_fn_t)(int argc, char * argv[]);
+
+typedef struct {
+
+	uint32_t total;
+	uint32_t skip;				/* segunda pasada: registros a saltear */
+	uint32_t left;				/* y a imprimir: no pasa de lo contado */
+} log_walk_t;
+
+typedef struct {
+
+	const char * name;
+	cmd_fn_t fn;
+	const char * help;
+} cmd_t;
+
+
+/********************** internal functions declaration ***********************/
+static void cmd_help_(int argc, char * argv[]);
+static void cmd_ev_(int argc, char * argv[]);
+static void cmd_stats_(int argc, char * argv[]);
+static void cmd_reset_(int argc, char * argv[]);
+static void cmd_get_(int argc, char * argv[]);
+static void cmd_set_(int argc, char * argv[]);
+static void cmd_defaults_(int argc, char * argv[]);
+#if 1 == PARAMS_CONFIG_PERSIST
+static void cmd_save_(int argc, char * argv[]);
+#endif
+#if 1 == FLASH_LOG_CONFIG_ENABLE
+static void cmd_log_(int argc, char * argv[]);
+#endif
+#if 1 == EVENT_REC_CONFIG_ENABLE
+static void cmd_evrec_(int argc, char * argv[]);
+#endif
+
+/********************** internal data definition *****************************/
+static const cmd_t cmds_[] = {
+
+	{"help",     cmd_help_,      "lista de comandos"},
+	{"ev",       cmd_ev_,        "ev pulso|corto|largo: inyecta un evento en AO UI"},
+	{"stats",    cmd_stats_,     "contadores del sistema"},
+	{"reset",    cmd_reset_,     "pone en cero rechazos, latencias y desalojos"},
+	{"get",      cmd_get_,       "get [param]: muestra parametros"},
+	{"set",      cmd_set_,       "set param valor: cambia un parametro"},
+	{"defaults", cmd_defaults_,  "vuelve los parametros a sus valores por defecto"},
+#if 1 == PARAMS_CONFIG_PERSIST
+	{"save",     cmd_save_,      "guarda los parametros en flash (detiene la CPU)"},
+#endif
+#if 1 == FLASH_LOG_CONFIG_ENABLE
+	{"log",      cmd_log_,       "log [n|info]: ultimos n registros de flash (20)"},
+#endif
+#if 1 == EVENT_REC_CONFIG_ENABLE
+	{"evrec",    cmd_evrec_,     "vuelca y reinicia el grabador de eventos de AO UI"},
+#endif
+};
+
+static const char * const event_names_[MSG_EVENT__N] = {"pulso", "corto", "largo"};
+
+static char line_[CONSOLE_CONFIG_LINE_LEN];
+static uint8_t line_n_;
+static bool line_overflow_;
+static char reply_buf_[REPLY_LEN_];
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static StaticTask_t task_console_tcb_;
+static StackType_t task_console_stack_[CONSOLE_CONFIG_STACK_SIZE];
+#endif
+
+/********************** internal functions definition ************************/
+static void reply_(const char * fmt, ...) {
+
+	va_list ap;
+	int n;
+
+	va_start(ap, fmt);
+	n = vsnprintf(reply_buf_, sizeof(reply_buf_) - 2, fmt, ap);
+	va_end(ap);
+
+	if(0 > n)
+		return;
+	if((int)sizeof(reply_buf_) - 2 <= n)
+		n = sizeof(reply_buf_) - 3;
+	reply_buf_[n++] = '\r';
+	reply_buf_[n++] = '\n';
+	uart_io_write((const uint8_t *)reply_buf_, (uint16_t)n, TX_TIMEOUT_);
+}
+
+static void reply_param_(param_id_t id) {
+
+	const param_desc_t * d = param_desc(id);
+
+	reply_("%-10s = %-5lu [%lu..%lu]%s", d->name, (unsigned long)param_get(id), (unsigned long)d->min,
+		   (unsigned long)d->max, (d->flags & PARAM_F_BOOT) ? " al reiniciar" : "");
+}
+
+static void cmd_help_(int argc, char * argv[]) {
+
+	(void)argc;
+	(void)argv;
+	for(uint8_t i = 0; i < sizeof(cmds_) / sizeof(cmds_[0]); i++)
+		reply_("  %-8s %s", cmds_[i].name, cmds_[i].help);
+}
+
+static void cmd_ev_(int argc, char * argv[]) {
+
+	if(2 != argc) {
+
+		reply_("err: ev pulso|corto|largo");
+		return;
+	}
+
+	for(uint8_t e = 0; e < MSG_EVENT__N; e++) {
+
+		if(0 == strcmp(argv[1], event_names_[e])) {
+
+			/* mismo camino que el boton: pasa por el limitador de tasa */
+			reply_("%s", ao_ui_send_console_event((msg_event_t)e) ? "ok" : "err: evento rechazado");
+			return;
+		}
+	}
+	reply_("err: evento desconocido");
+}
+
+static void cmd_stats_(int argc, char * argv[]) {
+
+	work_stats_t work;
+	uint32_t avg;
+	uint32_t max;
+
+	(void)argc;
+	(void)argv;
+	work_get_stats(&work);
+	ao_ui_get_latency(&avg, &max);
+
+	reply_("tick %lu ms, heap libre %u B (min %u B)", (unsigned long)xTaskGetTickCount(),
+		   (unsigned)xPortGetFreeHeapSize(), (unsigned)xPortGetMinimumEverFreeHeapSize());
+	reply_("ui: cola %u, rechazos %lu/%lu/%lu, latencia %lu/%lu us", ao_ui_get_queue_depth(),
+		   (unsigned long)ao_ui_get_rejected(MSG_EVENT_BUTTON_PULSE),
+		   (unsigned long)ao_ui_get_rejected(MSG_EVENT_BUTTON_SHORT),
+		   (unsigned long)ao_ui_get_rejected(MSG_EVENT_BUTTON_LONG),
+		   (unsigned long)(avg / cycles_per_us), (unsigned long)(max / cycles_per_us));
+	reply_("led: cola %u, desalojos %lu, hold %lu ms", prio_queue_count(),
+		   (unsigned long)prio_queue_evicted(), (unsigned long)ao_led_get_hold_ms());
+	reply_("work: ejecutados %lu, descartados %lu/%lu/%lu", (unsigned long)work.executed,
+		   (unsigned long)work.dropped[WORK_PRIO_HIGH], (unsigned long)work.dropped[WORK_PRIO_NORMAL],
+		   (unsigned long)work.dropped[WORK_PRIO_LOW]);
+	reply_("uart: tx %lu B, rx %lu B (perdidos %lu), alarmas stack %lu",
+		   (unsigned long)uart_io_get_tx_bytes(), (unsigned long)uart_io_get_rx_bytes(),
+		   (unsigned long)uart_io_get_rx_dropped(), (unsigned long)task_monitor_get_alarms());
+}
+
+static void cmd_reset_(int argc, char * argv[]) {
+
+	(void)argc;
+	(void)argv;
+	ao_ui_reset_stats();
+	prio_queue_reset_evicted();
+	reply_("ok");
+}
+
+static void cmd_get_(int argc, char * argv[]) {
+
+	param_id_t id;
+
+	if(2 == argc) {
+
+		if(param_find(argv[1], &id))
+			reply_param_(id);
+		else
+			reply_("err: parametro desconocido");
+		return;
+	}
+
+	for(uint8_t i = 0; i < PARAM__N; i++)
+		reply_param_((param_id_t)i);
+}
+
+static void cmd_set_(int argc, char * argv[]) {
+
+	param_id_t id;
+	char * end;
+	unsigned long value;
+
+	if(3 != argc) {
+
+		reply_("err: set param valor");
+		return;
+	}
+
+	value = strtoul(argv[2], &end, 0);
+
+	if(!param_find(argv[1], &id)) {
+
+		reply_("err: parametro desconocido");
+	} else if('\0' != *end || argv[2] == end) {
+
+		reply_("err: valor invalido");
+	} else if(!param_set(id, (uint32_t)value)) {
+
+		reply_("err: fuera de rango o umbrales no crecientes");
+	} else {
+
+		reply_param_(id);
+	}
+}
+
+static void cmd_defaults_(int argc, char * argv[]) {
+
+	(void)argc;
+	(void)argv;
+	params_defaults();
+	reply_("ok");
+}
+
+#if 1 == PARAMS_CONFIG_PERSIST
+static void cmd_save_(int argc, char * argv[]) {
+
+	(void)argc;
+	(void)argv;
+	reply_("%s", params_save() ? "ok" : "err: fallo la escritura en flash");
+}
+#endif
+
+#if 1 == FLASH_LOG_CONFIG_ENABLE
+static bool log_count_(const flash_log_rec_t * rec, void * ctx) {
+
+	(void)rec;
+	((log_walk_t *)ctx)->total++;
+	return true;
+}
+
+static bool log_print_(const flash_log_rec_t * rec, void * ctx) {
+
+	log_walk_t * walk = ctx;
+
+	if(0 < walk->skip) {
+
+		walk->skip--;
+		return true;
+	}
+
+	if(FLASH_LOG_REC_METRICS == rec->type) {
+
+		const flash_log_metrics_t * m = &rec->payload.metrics;
+
+		reply_("%9lu M cpu %lu heap %lu/%lu rech %lu desal %lu drop %lu lat %lu/%lu us",
+			   (unsigned long)rec->tick, (unsigned long)m->cpu_1s_pm, (unsigned long)m->heap_free,
+			   (unsigned long)m->heap_min, (unsigned long)m->ui_rejected, (unsigned long)m->pq_evicted,
+			   (unsigned long)m->work_dropped, (unsigned long)m->ui_latency_avg_us,
+			   (unsigned long)m->ui_latency_max_us);
+	} else if(FLASH_LOG_REC_FAULT == rec->type) {
+
+		const flash_log_fault_t * f = &rec->payload.fault;
+
+		reply_("%9lu F %lu valor 0x%08lx %.*s", (unsigned long)rec->tick, (unsigned long)f->code,
+			   (unsigned long)f->value, FLASH_LOG_TAG_LEN, f->tag);
+	} else {
+
+		reply_("%9lu ? tipo %u, %u B", (unsigned long)rec->tick, rec->type, rec->len);
+	}
+	return (0 < --walk->left);
+}
+
+static void cmd_log_(int argc, char * argv[]) {
+
+	log_walk_t walk = {0, 0, 0};
+	unsigned long n = LOG_DEFAULT_N_;
+	char * end;
+
+	if(2 == argc && 0 == strcmp(argv[1], "info")) {
+
+		log_store_info_t info;
+		uint32_t dropped;
+
+		flash_log_get_info(&info, &dropped);
+		reply_("sectores %u, activo %u (seq %lu, borrados %lu), pagina %lu/%lu, descartados %lu",
+			   info.sectors, info.active, (unsigned long)info.seq, (unsigned long)info.erase_count,
+			   (unsigned long)info.head_page, (unsigned long)info.pages_per_sector, (unsigned long)dropped);
+		return;
+	}
+
+	if(2 < argc) {
+
+		reply_("err: log [n|info]");
+		return;
+	}
+
+	if(2 == argc) {
+
+		n = strtoul(argv[1], &end, 0);
+
+		if('\0' != *end || argv[1] == end) {
+
+			reply_("err: cantidad invalida");
+			return;
+		}
+	}
+
+	if(!flash_log_sync(LOG_SYNC_TIMEOUT_))
+		reply_("aviso: la ultima pagina no se grabo");
+
+	/* flash_log_foreach no retiene store_mutex_ mientras se imprime, asi que
+	 * entre las dos pasadas se pueden grabar paginas nuevas */
+	flash_log_foreach(log_count_, &walk);
+	walk.skip = (walk.total > n) ? walk.total - n : 0;
+	walk.left = walk.total - walk.skip;
+	if(0 < walk.left)
+		flash_log_foreach(log_print_, &walk);
+}
+#endif
+
+#if 1 == EVENT_REC_CONFIG_ENABLE
+/* Mismo volcado que dispara task_monitor, pero por uart_io y no por el logger. */
+static void cmd_evrec_(int argc, char * argv[]) {
+
+	(void)argc;
+	(void)argv;
+
+	if(!event_rec_stream(reply_))
+		reply_("err: volcado en curso");
+}
+#endif
+
+/* Parte la linea en palabras (in situ) y despacha el comando. */
+static void execute_(char * line) {
+
+	char * argv[CONSOLE_CONFIG_MAX_ARGS];
+	int argc = 0;
+	char * save;
+	char * tok = strtok_r(line, " \t", &save);
+
+	while(NULL != tok && CONSOLE_CONFIG_MAX_ARGS > argc) {
+
+		argv[argc++] = tok;
+		tok = strtok_r(NULL, " \t", &save);
+	}
+
+	if(0 == argc)
+		return;
+
+	for(uint8_t i = 0; i < sizeof(cmds_) / sizeof(cmds_[0]); i++) {
+
+		if(0 == strcmp(argv[0], cmds_[i].name)) {
+
+			cmds_[i].fn(argc, argv);
+			return;
+		}
+	}
+	reply_("err: comando desconocido (help)");
+}
+
+static void feed_(char c) {
+
+	if('\r' == c || '\n' == c) {
+
+		if(line_overflow_) {
+
+			reply_("err: linea larga");
+		} else if(0 < line_n_) {
+
+			line_[line_n_] = '\0';
+			execute_(line_);
+		}
+		line_n_ = 0;
+		line_overflow_ = false;
+	} else if('\b' == c || 0x7F == c) {
+
+		if(0 < line_n_)
+			line_n_--;
+	} else if(CONSOLE_CONFIG_LINE_LEN - 1 > line_n_) {
+
+		line_[line_n_++] = c;
+	} else {
+
+		line_overflow_ = true;
+	}
+}
+
+static void task_console_(void * argument) {
+
+	uint8_t chunk[16];
+
+	while(true) {
+
+		size_t n = uart_io_read(chunk, sizeof(chunk), portMAX_DELAY);
+
+		for(size_t i = 0; i < n; i++)
+			feed_((char)chunk[i]);
+	}
+}
+
+/********************** external functions definition ************************/
+bool console_init(void) {
+
+	TaskHandle_t h = NULL;
+
+	if(!uart_io_init())
+		return false;
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	h = xTaskCreateStatic(task_console_, "task_console", CONSOLE_CONFIG_STACK_SIZE, NULL,
+						  CONSOLE_CONFIG_PRIORITY, task_console_stack_, &task_console_tcb_);
+#else
+	xTaskCreate(task_console_, "task_console", CONSOLE_CONFIG_STACK_SIZE, NULL, CONSOLE_CONFIG_PRIORITY, &h);
+#endif
+
+	if(NULL == h) {
+
+		LOGGER_INFO("[CON] error en console_init().");
+		return false;
+	}
+	task_monitor_register(h, CONSOLE_CONFIG_STACK_SIZE);
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("console", sizeof(line_) + sizeof(reply_buf_) +
+					  sizeof(task_console_tcb_) + sizeof(task_console_stack_));
+#endif
+	return true;
+}
+
+#endif
+
+/********************** end of file ******************************************/
@@ -0,0 +1,152 @@
+/*
+ * cpu_load.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "dwt.h"
+
+#include "cpu_load.h"
+
+/********************** macros and definitions *******************************/
+#define HISTORY_                (CPU_LOAD_CONFIG_HISTORY_S)
+#define TICKS_PER_BUCKET_       (pdMS_TO_TICKS(1000))
+
+/********************** internal data definition *****************************/
+/* Escrito por la tarea idle, leido por cualquier tarea: todo bajo seccion critica. */
+static uint32_t idle_cycles_[HISTORY_];	/* idle de cada segundo cerrado */
+static uint16_t filled_;
+static uint32_t bucket_;				/* segundo en curso, en ticks / TICKS_PER_BUCKET_ */
+static uint32_t bucket_idle_;			/* idle acumulado del segundo en curso */
+static uint32_t last_cycles_;
+static uint32_t loop_min_ = UINT32_MAX;
+static bool started_ = false;
+
+/********************** internal functions declaration ***********************/
+static void close_buckets_(uint32_t now_bucket);
+static uint16_t load_pm_(uint16_t seconds);
+
+/********************** internal functions definition ************************/
+/* Cierra los segundos transcurridos; los que pasaron sin correr el idle quedan en 0. */
+static void close_buckets_(uint32_t now_bucket) {
+
+	uint32_t elapsed = now_bucket - bucket_;
+
+	if(HISTORY_ < elapsed) {
+
+		memset(idle_cycles_, 0, sizeof(idle_cycles_));
+		filled_ = HISTORY_;
+		bucket_ = now_bucket;
+		bucket_idle_ = 0;
+		return;
+	}
+
+	while(bucket_ != now_bucket) {
+
+		idle_cycles_[bucket_ % HISTORY_] = bucket_idle_;
+		bucket_idle_ = 0;
+		bucket_++;
+
+		if(filled_ < HISTORY_)
+			filled_++;
+	}
+}
+
+/* Carga de los ultimos 'seconds' segundos cerrados, en por mil. */
+static uint16_t load_pm_(uint16_t seconds) {
+
+	uint64_t idle = 0;
+	uint64_t total;
+
+	if(seconds > filled_)
+		seconds = filled_;
+
+	if(0 == seconds)
+		return 0;
+
+	for(uint16_t i = 1; i <= seconds; i++)
+		idle += idle_cycles_[(bucket_ - i) % HISTORY_];
+
+	total = (uint64_t)SystemCoreClock * seconds;
+
+	if(idle >= total)
+		return 0;
+	return (uint16_t)(1000 - (idle * 1000) / total);
+}
+
+/********************** external functions definition ************************/
+void cpu_load_on_idle(void) {
+
+	uint32_t now = cycle_counter_get();
+	uint32_t delta = now - last_cycles_;
+
+	taskENTER_CRITICAL();
+	close_buckets_(xTaskGetTickCount() / TICKS_PER_BUCKET_);
+
+	if(started_) {
+
+		if(delta < loop_min_)
+			loop_min_ = delta;
+
+		if(delta <= loop_min_ * CPU_LOAD_CONFIG_GAP_FACTOR)
+			bucket_idle_ += delta;
+	}
+	started_ = true;
+	last_cycles_ = now;
+	taskEXIT_CRITICAL();
+}
+
+/* Para tiempo idle que no pasa por el hook (por ejemplo, sueno tickless). Se
+ * llama antes de que el kernel sume los ticks dormidos: si el sueno cruzo el
+ * limite de un segundo, la parte posterior va a la cubeta nueva. */
+void cpu_load_credit_idle(uint32_t cycles) {
+
+	uint32_t cycles_per_tick = SystemCoreClock / configTICK_RATE_HZ;
+	uint32_t start = xTaskGetTickCount();
+	uint32_t end = start + cycles / cycles_per_tick;
+
+	taskENTER_CRITICAL();
+	close_buckets_(start / TICKS_PER_BUCKET_);
+
+	if(end / TICKS_PER_BUCKET_ != start / TICKS_PER_BUCKET_) {
+
+		uint32_t after = (end % TICKS_PER_BUCKET_) * cycles_per_tick;
+
+		if(after > cycles)
+			after = cycles;
+		bucket_idle_ += cycles - after;
+		close_buckets_(end / TICKS_PER_BUCKET_);
+		bucket_idle_ += after;
+	} else {
+
+		bucket_idle_ += cycles;
+	}
+	last_cycles_ = cycle_counter_get();		/* la vuelta actual ya quedo contada */
+	taskEXIT_CRITICAL();
+}
+
+bool cpu_load_get(cpu_load_t * load) {
+
+	if(NULL == load)
+		return false;
+
+	taskENTER_CRITICAL();
+	close_buckets_(xTaskGetTickCount() / TICKS_PER_BUCKET_);
+	load->load_1s_pm = load_pm_(1);
+	load->load_10s_pm = load_pm_(10);
+	load->load_60s_pm = load_pm_(60);
+	load->seconds = filled_;
+	load->idle_loop_cycles = (UINT32_MAX == loop_min_) ? 0 : loop_min_;
+	taskEXIT_CRITICAL();
+	return 0 != load->seconds;
+}
+
+/********************** end of file ******************************************/
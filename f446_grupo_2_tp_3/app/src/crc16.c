@@ -0,0 +1,32 @@
+/*
+ * crc16.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "crc16.h"
+
+/********************** internal data definition *****************************/
+static const uint16_t nibble_table_[16] = {
+
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/********************** external functions definition ************************/
+uint16_t crc16_update(uint16_t crc, const uint8_t * data, size_t len) {
+
+	for(size_t i = 0; i < len; i++) {
+
+		crc = (uint16_t)((crc << 4) ^ nibble_table_[(crc >> 12) ^ (data[i] >> 4)]);
+		crc = (uint16_t)((crc << 4) ^ nibble_table_[(crc >> 12) ^ (data[i] & 0x0F)]);
+	}
+	return crc;
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,156 @@
+/*
+ * event_rec.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+
+#include "ao_ui.h"
+#include "priority_queue.h"
+#include "event_rec.h"
+
+#if 1 == EVENT_REC_CONFIG_ENABLE
+
+/********************** macros and definitions *******************************/
+#define REPLAY_FIRST_MS_        (50)	/* primer muestreo del boton en un escenario */
+
+/********************** internal data definition *****************************/
+static event_rec_t ring_[EVENT_REC_CONFIG_LEN];
+static uint16_t head_;					/* proximo registro a escribir */
+static uint16_t n_;
+static bool triggered_;
+static bool frozen_;					/* durante el volcado no se graba */
+
+static const char * const button_name_[MSG_EVENT__N] = {
+
+	[MSG_EVENT_BUTTON_PULSE] = "BUTTON_TYPE_PULSE",
+	[MSG_EVENT_BUTTON_SHORT] = "BUTTON_TYPE_SHORT",
+	[MSG_EVENT_BUTTON_LONG]  = "BUTTON_TYPE_LONG",
+};
+
+static const char * const src_name_[] = {
+
+	[EVENT_REC_SRC_BUTTON]  = "btn",
+	[EVENT_REC_SRC_CONSOLE] = "con",
+};
+
+/********************** internal functions declaration ***********************/
+static void log_line_(const char * fmt, ...);
+
+/********************** internal functions definition ************************/
+static void log_line_(const char * fmt, ...) {
+
+	char line[LOGGER_CONFIG_MAXLEN - 2];	/* deja lugar para el '\n' */
+	va_list ap;
+
+	va_start(ap, fmt);
+	vsnprintf(line, sizeof(line), fmt, ap);
+	va_end(ap);
+	LOGGER_LOG("%s\n", line);
+}
+
+/********************** external functions definition ************************/
+void event_rec_on_send(uint8_t event, event_rec_result_t result, uint8_t ui_depth, event_rec_src_t src) {
+
+	event_rec_t * rec;
+	uint16_t pq_depth = prio_queue_count();
+
+	taskENTER_CRITICAL();
+	if(!frozen_) {
+
+		rec = &ring_[head_];
+		rec->tick = xTaskGetTickCount();
+		rec->cycles = cycle_counter_get();
+		rec->event = event;
+		rec->result = (uint8_t)result;
+		rec->ui_depth = ui_depth;
+		rec->pq_depth = (uint8_t)pq_depth;
+		rec->src = (uint8_t)src;
+		head_ = (head_ + 1) % EVENT_REC_CONFIG_LEN;
+
+		if(EVENT_REC_CONFIG_LEN > n_)
+			n_++;
+
+		if(EVENT_REC_OK != result || EVENT_REC_CONFIG_TRIGGER_DEPTH <= pq_depth)
+			triggered_ = true;
+	}
+	taskEXIT_CRITICAL();
+}
+
+bool event_rec_triggered(void) {
+
+	return triggered_;
+}
+
+void event_rec_dump(void) {
+
+	event_rec_stream(log_line_);
+}
+
+/* Del mas viejo al mas nuevo, con tiempos relativos al primero para poder
+ * comparar el volcado de la unidad con el de la repeticion. Mientras se
+ * imprime el anillo queda congelado (se pierden los eventos de ese lapso) y
+ * no se toma ningun lock; false si ya hay otro volcado en curso. */
+bool event_rec_stream(event_rec_print_t print) {
+
+	uint16_t first;
+	uint16_t n;
+	const event_rec_t * rec0;
+
+	taskENTER_CRITICAL();
+	if(frozen_) {
+
+		taskEXIT_CRITICAL();
+		return false;
+	}
+	frozen_ = true;
+	n = n_;
+	first = (head_ + EVENT_REC_CONFIG_LEN - n) % EVENT_REC_CONFIG_LEN;
+	taskEXIT_CRITICAL();
+
+	rec0 = &ring_[first];
+
+	print("[EVREC] volcado de %u eventos", n);
+	print("evrec,ms,cyc,ev,src,res,ui,pq");
+	for(uint16_t i = 0; i < n; i++) {
+
+		const event_rec_t * rec = &ring_[(first + i) % EVENT_REC_CONFIG_LEN];
+
+		print("evrec,%lu,%lu,%u,%s,%u,%u,%u", (unsigned long)((rec->tick - rec0->tick) * portTICK_PERIOD_MS),
+			  (unsigned long)(rec->cycles - rec0->cycles), rec->event, src_name_[rec->src], rec->result,
+			  rec->ui_depth, rec->pq_depth);
+	}
+
+	/* los de la consola no caen en la grilla del boton: quedan comentados */
+	print("/* scenario_input_t */");
+	for(uint16_t i = 0; i < n; i++) {
+
+		const event_rec_t * rec = &ring_[(first + i) % EVENT_REC_CONFIG_LEN];
+
+		print("%s{%lu, %s},", (EVENT_REC_SRC_CONSOLE == rec->src) ? "// consola: " : "",
+			  (unsigned long)((rec->tick - rec0->tick) * portTICK_PERIOD_MS + REPLAY_FIRST_MS_),
+			  (MSG_EVENT__N > rec->event) ? button_name_[rec->event] : "BUTTON_TYPE_NONE");
+	}
+
+	taskENTER_CRITICAL();
+	n_ = 0;
+	triggered_ = false;
+	frozen_ = false;
+	taskEXIT_CRITICAL();
+	return true;
+}
+
+#endif
+
+/********************** end of file ******************************************/
@@ -0,0 +1,346 @@
+/*
+ * flash_log.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+
+#include "app.h"
+#include "ao_ui.h"
+#include "priority_queue.h"
+#include "work_queue.h"
+#include "cpu_load.h"
+#include "task_monitor.h"
+#include "uart_io.h"
+#include "log_store.h"
+#include "flash_log.h"
+
+#if 1 == FLASH_LOG_CONFIG_ENABLE
+
+/********************** macros and definitions *******************************/
+#define REC_HDR_SIZE_           (6)		/* type u8, len u8, tick u32 (sin alinear) */
+
+typedef struct {
+
+	flash_log_cb_t cb;
+	void * ctx;
+} foreach_ctx_t;
+
+/********************** internal data definition *****************************/
+/* pagina en llenado: page_[fill_]; con pending_ la otra espera ser grabada */
+static uint8_t page_[2][LOG_STORE_PAGE_DATA_SIZE];
+static uint16_t used_[2];
+static uint8_t fill_;
+static bool pending_;
+static bool sync_req_;
+static uint32_t dropped_;
+static bool running_ = false;
+static TaskHandle_t task_;
+static SemaphoreHandle_t store_mutex_;		/* log_store no es reentrante */
+static SemaphoreHandle_t sync_done_;
+static uint8_t walk_page_[LOG_STORE_PAGE_DATA_SIZE];	/* foreach: copia fuera del mutex */
+static flash_log_rec_t rec_;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static StaticTask_t task_flog_tcb_;
+static StackType_t task_flog_stack_[FLASH_LOG_CONFIG_STACK_SIZE];
+static StaticSemaphore_t store_mutex_ctrl_;
+static StaticSemaphore_t sync_done_ctrl_;
+#endif
+
+/********************** internal functions definition ************************/
+/* Dentro de una seccion critica. */
+static void swap_(void) {
+
+	pending_ = true;
+	fill_ ^= 1;
+	used_[fill_] = 0;
+}
+
+static void snapshot_(void) {
+
+	flash_log_metrics_t m = {0};
+	work_stats_t work;
+	uint32_t avg;
+	uint32_t max;
+#if 1 == CPU_LOAD_CONFIG_ENABLE
+	cpu_load_t load;
+#endif
+
+	m.cpu_1s_pm = 0xFFFF;
+#if 1 == CPU_LOAD_CONFIG_ENABLE
+	if(cpu_load_get(&load))
+		m.cpu_1s_pm = load.load_1s_pm;
+#endif
+	work_get_stats(&work);
+	ao_ui_get_latency(&avg, &max);
+
+	m.heap_free = xPortGetFreeHeapSize();
+	m.heap_min = xPortGetMinimumEverFreeHeapSize();
+	for(uint8_t e = 0; e < MSG_EVENT__N; e++)
+		m.ui_rejected += ao_ui_get_rejected((msg_event_t)e);
+	m.pq_evicted = prio_queue_evicted();
+	m.work_dropped = work.dropped[WORK_PRIO_HIGH] + work.dropped[WORK_PRIO_NORMAL] + work.dropped[WORK_PRIO_LOW];
+	m.ui_latency_avg_us = avg / cycles_per_us;
+	m.ui_latency_max_us = max / cycles_per_us;
+	m.stack_alarms = task_monitor_get_alarms();
+#if 1 == UART_IO_CONFIG_ENABLE
+	m.uart_tx_bytes = uart_io_get_tx_bytes();
+#endif
+	flash_log_append(FLASH_LOG_REC_METRICS, &m, sizeof(m));
+}
+
+/* Graba la pagina pendiente y, si se pidio sync, tambien la que se esta llenando. */
+static void flush_(void) {
+
+	bool sync;
+	bool synced;
+
+	taskENTER_CRITICAL();
+	sync = sync_req_;
+	sync_req_ = false;
+	taskEXIT_CRITICAL();
+	synced = sync;
+
+	while(true) {
+
+		bool pend;
+		uint8_t idx;
+
+		taskENTER_CRITICAL();
+		if(!pending_ && sync && 0 < used_[fill_]) {
+
+			swap_();
+			sync = false;
+		}
+		pend = pending_;
+		idx = fill_ ^ 1;
+		taskEXIT_CRITICAL();
+
+		if(!pend)
+			break;
+
+		/* con pending_ en true nadie toca page_[idx] */
+		xSemaphoreTake(store_mutex_, portMAX_DELAY);
+		if(!log_store_write(page_[idx], used_[idx])) {
+
+			LOGGER_INFO("[FLOG] error al grabar la pagina");
+		}
+		xSemaphoreGive(store_mutex_);
+
+		taskENTER_CRITICAL();
+		pending_ = false;
+		taskEXIT_CRITICAL();
+	}
+
+	if(synced)
+		xSemaphoreGive(sync_done_);
+}
+
+static void task_flash_log_(void * argument) {
+
+	const TickType_t period = pdMS_TO_TICKS(FLASH_LOG_CONFIG_SNAPSHOT_S * 1000u);
+	TickType_t next = xTaskGetTickCount() + period;
+
+	while(true) {
+
+		int32_t left = (int32_t)(next - xTaskGetTickCount());
+
+		if(0 < left)
+			ulTaskNotifyTake(pdTRUE, (TickType_t)left);
+
+		if((int32_t)(next - xTaskGetTickCount()) <= 0) {
+
+			snapshot_();
+			next += period;
+		}
+		flush_();
+	}
+}
+
+static bool page_recs_(const uint8_t * data, uint16_t used, const foreach_ctx_t * user) {
+
+	uint16_t off = 0;
+
+	while(off + REC_HDR_SIZE_ <= used) {
+
+		rec_.type = data[off];
+		rec_.len = data[off + 1];
+
+		if(off + REC_HDR_SIZE_ + rec_.len > used)
+			break;
+		memcpy(&rec_.tick, &data[off + 2], sizeof(rec_.tick));
+		memset(&rec_.payload, 0, sizeof(rec_.payload));
+		memcpy(&rec_.payload, &data[off + REC_HDR_SIZE_], rec_.len);
+		off += REC_HDR_SIZE_ + rec_.len;
+
+		if(!user->cb(&rec_, user->ctx))
+			return false;
+	}
+	return true;
+}
+
+/********************** external functions definition ************************/
+bool flash_log_init(void) {
+
+	uint32_t csr;
+
+	if(running_)
+		return true;
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	store_mutex_ = xSemaphoreCreateMutexStatic(&store_mutex_ctrl_);
+	sync_done_ = xSemaphoreCreateBinaryStatic(&sync_done_ctrl_);
+#else
+	store_mutex_ = xSemaphoreCreateMutex();
+	sync_done_ = xSemaphoreCreateBinary();
+#endif
+
+	if(NULL == store_mutex_ || NULL == sync_done_ || !log_store_mount()) {
+
+		LOGGER_INFO("[FLOG] error en flash_log_init().");
+		return false;
+	}
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	task_ = xTaskCreateStatic(task_flash_log_, "task_flog", FLASH_LOG_CONFIG_STACK_SIZE, NULL,
+							  FLASH_LOG_CONFIG_PRIORITY, task_flog_stack_, &task_flog_tcb_);
+#else
+	xTaskCreate(task_flash_log_, "task_flog", FLASH_LOG_CONFIG_STACK_SIZE, NULL, FLASH_LOG_CONFIG_PRIORITY, &task_);
+#endif
+
+	if(NULL == task_) {
+
+		LOGGER_INFO("[FLOG] error al crear la tarea.");
+		return false;
+	}
+	task_monitor_register(task_, FLASH_LOG_CONFIG_STACK_SIZE);
+	running_ = true;
+
+	/* causa del ultimo reset (pin, software, watchdogs, brown-out, bajo consumo) */
+	csr = RCC->CSR;
+	__HAL_RCC_CLEAR_RESET_FLAGS();
+	flash_log_fault(FLASH_LOG_FAULT_RESET, csr, NULL);
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("flash_log", sizeof(page_) + sizeof(walk_page_) + sizeof(rec_) + sizeof(task_flog_tcb_) +
+					  sizeof(task_flog_stack_) + sizeof(store_mutex_ctrl_) + sizeof(sync_done_ctrl_));
+#endif
+	return true;
+}
+
+/* Solo desde tareas. Copia el registro a la pagina en RAM; no toca la flash. */
+bool flash_log_append(flash_log_rec_type_t type, const void * payload, uint8_t len) {
+
+	uint8_t hdr[REC_HDR_SIZE_];
+	uint32_t tick = xTaskGetTickCount();
+	bool swapped = false;
+
+	if(!running_ || LOG_STORE_PAGE_DATA_SIZE < REC_HDR_SIZE_ + len)
+		return false;
+
+	hdr[0] = (uint8_t)type;
+	hdr[1] = len;
+	memcpy(&hdr[2], &tick, sizeof(tick));
+
+	taskENTER_CRITICAL();
+	if(LOG_STORE_PAGE_DATA_SIZE < used_[fill_] + REC_HDR_SIZE_ + len) {
+
+		if(pending_) {
+
+			dropped_++;
+			taskEXIT_CRITICAL();
+			return false;
+		}
+		swap_();
+		swapped = true;
+	}
+	memcpy(&page_[fill_][used_[fill_]], hdr, REC_HDR_SIZE_);
+	memcpy(&page_[fill_][used_[fill_] + REC_HDR_SIZE_], payload, len);
+	used_[fill_] += REC_HDR_SIZE_ + len;
+	taskEXIT_CRITICAL();
+
+	if(swapped)
+		xTaskNotifyGive(task_);
+	return true;
+}
+
+/* Agrega la falla y pide grabarla sin esperar. */
+void flash_log_fault(flash_log_fault_code_t code, uint32_t value, const char * tag) {
+
+	flash_log_fault_t f = {0};
+
+	f.code = code;
+	f.value = value;
+	if(NULL != tag)
+		strncpy(f.tag, tag, sizeof(f.tag));
+
+	if(!flash_log_append(FLASH_LOG_REC_FAULT, &f, sizeof(f)))
+		return;
+
+	taskENTER_CRITICAL();
+	sync_req_ = true;
+	taskEXIT_CRITICAL();
+	xTaskNotifyGive(task_);
+}
+
+/* Graba la pagina a medio llenar y espera. Un solo llamador a la vez. */
+bool flash_log_sync(TickType_t timeout) {
+
+	if(!running_)
+		return false;
+
+	xSemaphoreTake(sync_done_, 0);
+	taskENTER_CRITICAL();
+	sync_req_ = true;
+	taskEXIT_CRITICAL();
+	xTaskNotifyGive(task_);
+	return (pdTRUE == xSemaphoreTake(sync_done_, timeout));
+}
+
+/* Registros ya grabados, del mas viejo al mas nuevo. Copia una pagina por vez
+ * con store_mutex_ y llama a cb sin tomarlo: la tarea de grabacion no espera a
+ * un cb que imprime por la UART. Un solo llamador a la vez. */
+void flash_log_foreach(flash_log_cb_t cb, void * ctx) {
+
+	foreach_ctx_t user = {cb, ctx};
+	log_store_cursor_t cur = {0, 0};
+	uint16_t used;
+	bool more;
+
+	if(!running_)
+		return;
+
+	do {
+
+		xSemaphoreTake(store_mutex_, portMAX_DELAY);
+		more = log_store_read(&cur, walk_page_, &used);
+		xSemaphoreGive(store_mutex_);
+	} while(more && page_recs_(walk_page_, used, &user));
+}
+
+void flash_log_get_info(log_store_info_t * info, uint32_t * dropped) {
+
+	if(running_) {
+
+		xSemaphoreTake(store_mutex_, portMAX_DELAY);
+		log_store_get_info(info);
+		xSemaphoreGive(store_mutex_);
+	} else {
+
+		memset(info, 0, sizeof(*info));
+	}
+	*dropped = dropped_;
+}
+
+#endif
+
+/********************** end of file ******************************************/
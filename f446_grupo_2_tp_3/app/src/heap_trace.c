@@ -0,0 +1,262 @@
+/*
+ * heap_trace.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <malloc.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+
+#include "heap_trace.h"
+
+/********************** macros and definitions *******************************/
+#define HIST_MIN_SHIFT_         (4)		/* primer bin: hasta 16 B */
+
+/********************** internal data definition *****************************/
+/* Los hooks corren dentro de pvPortMalloc/vPortFree con el scheduler suspendido:
+ * no hace falta otra proteccion entre tareas. */
+static heap_trace_site_t sites_[HEAP_TRACE_CONFIG_MAX_SITES];
+static uint8_t sites_n_;
+static uint32_t allocs_;
+static uint32_t frees_;
+static uint32_t failed_;
+static uint32_t live_bytes_;
+static uint32_t peak_live_bytes_;
+static uint32_t alloc_hist_[HEAP_TRACE_CONFIG_HIST_BINS];
+#if 0 < HEAP_TRACE_CONFIG_RING_LEN
+static heap_trace_event_t ring_[HEAP_TRACE_CONFIG_RING_LEN];
+static uint32_t ring_count_;
+#endif
+
+/********************** internal functions declaration ***********************/
+static heap_trace_site_t * site_of_(const void * site);
+static uint8_t hist_bin_(size_t size);
+static void ring_push_(const void * ptr, size_t size, const void * site, bool is_free);
+static void ring_dump_(void);
+
+/********************** internal functions definition ************************/
+static heap_trace_site_t * site_of_(const void * site) {
+
+	for(uint8_t i = 0; i < sites_n_; i++) {
+
+		if(sites_[i].site == site)
+			return &sites_[i];
+	}
+
+	if(HEAP_TRACE_CONFIG_MAX_SITES <= sites_n_)
+		return NULL;
+	sites_[sites_n_].site = site;
+	return &sites_[sites_n_++];
+}
+
+static uint8_t hist_bin_(size_t size) {
+
+	uint8_t bin = 0;
+
+	size = (size - 1) >> HIST_MIN_SHIFT_;
+
+	while(size && bin < (HEAP_TRACE_CONFIG_HIST_BINS - 1)) {
+
+		size >>= 1;
+		bin++;
+	}
+	return bin;
+}
+
+static void ring_push_(const void * ptr, size_t size, const void * site, bool is_free) {
+
+#if 0 < HEAP_TRACE_CONFIG_RING_LEN
+	heap_trace_event_t * ev = &ring_[ring_count_ % HEAP_TRACE_CONFIG_RING_LEN];
+
+	ev->tick = xTaskGetTickCount();
+	ev->ptr = ptr;
+	ev->site = site;
+	ev->size = (uint16_t)size;
+	ev->is_free = is_free;
+	ring_count_++;
+#else
+	(void)ptr; (void)size; (void)site; (void)is_free;
+#endif
+}
+
+/* De a un evento por vez para no ocupar stack; corta si el anillo ya piso lo que
+ * faltaba volcar. Formato leido por tools/heap_replay. */
+static void ring_dump_(void) {
+
+#if 0 < HEAP_TRACE_CONFIG_RING_LEN
+	uint32_t first;
+	uint32_t end;
+
+	vTaskSuspendAll();
+	end = ring_count_;
+	xTaskResumeAll();
+	first = (end > HEAP_TRACE_CONFIG_RING_LEN) ? end - HEAP_TRACE_CONFIG_RING_LEN : 0;
+
+	for(uint32_t i = first; i < end; i++) {
+
+		heap_trace_event_t ev;
+		bool valid;
+
+		vTaskSuspendAll();
+		valid = (ring_count_ - i <= HEAP_TRACE_CONFIG_RING_LEN);
+		ev = ring_[i % HEAP_TRACE_CONFIG_RING_LEN];
+		xTaskResumeAll();
+
+		if(!valid)
+			break;
+		LOGGER_INFO("[HEAP] ev %lu %c %p %u", (unsigned long)ev.tick, ev.is_free ? 'f' : 'a', ev.ptr,
+					(unsigned)ev.size);
+	}
+#endif
+}
+
+/********************** external functions definition ************************/
+/* Devuelve la marca que el heap guarda en la cabecera del bloque: indice del
+ * sitio + 1, o 0 si la tabla de sitios esta llena. */
+uint8_t heap_trace_on_malloc(void * ptr, size_t size, const void * site) {
+
+	uint8_t tag = 0;
+
+	if(NULL == ptr) {
+
+		failed_++;
+		return 0;
+	}
+	heap_trace_site_t * s = site_of_(site);
+
+	if(NULL != s) {
+
+		s->allocs++;
+		s->live_bytes += size;
+		tag = (uint8_t)(s - sites_) + 1;
+	}
+	allocs_++;
+	live_bytes_ += size;
+
+	if(live_bytes_ > peak_live_bytes_)
+		peak_live_bytes_ = live_bytes_;
+	alloc_hist_[hist_bin_(size)]++;
+	ring_push_(ptr, size, site, false);
+	return tag;
+}
+
+/* site es quien libera (para el anillo); tag, la marca de la cabecera: las
+ * cuentas por sitio se descuentan en el sitio que asigno el bloque. */
+void heap_trace_on_free(void * ptr, size_t size, const void * site, uint8_t tag) {
+
+	heap_trace_site_t * s = (0 < tag && tag <= sites_n_) ? &sites_[tag - 1] : NULL;
+
+	if(NULL != s) {
+
+		s->frees++;
+		s->live_bytes -= (s->live_bytes >= size) ? size : s->live_bytes;
+	}
+	frees_++;
+	live_bytes_ -= (live_bytes_ >= size) ? size : live_bytes_;
+	ring_push_(ptr, size, site, true);
+}
+
+void heap_trace_snapshot(heap_trace_snapshot_t * snap) {
+
+	HeapStats_t stats;
+	struct mallinfo mi;
+
+	memset(snap, 0, sizeof(*snap));
+	vPortGetHeapStats(&stats);
+	mi = mallinfo();
+
+	vTaskSuspendAll();
+	snap->allocs = allocs_;
+	snap->frees = frees_;
+	snap->failed = failed_;
+	snap->live_bytes = live_bytes_;
+	snap->peak_live_bytes = peak_live_bytes_;
+	memcpy(snap->alloc_hist, alloc_hist_, sizeof(alloc_hist_));
+	xTaskResumeAll();
+
+	snap->free_bytes = stats.xAvailableHeapSpaceInBytes;
+	snap->min_ever_free_bytes = xPortGetMinimumEverFreeHeapSize();
+	snap->largest_free_block = stats.xSizeOfLargestFreeBlockInBytes;
+	snap->smallest_free_block = (0 == stats.xNumberOfFreeBlocks) ? 0 : stats.xSizeOfSmallestFreeBlockInBytes;
+	snap->free_blocks = stats.xNumberOfFreeBlocks;
+
+	if(0 != snap->free_bytes)
+		snap->fragmentation_pct = (uint8_t)(100 - ((snap->largest_free_block * 100) / snap->free_bytes));
+	snap->newlib_arena = mi.arena;
+	snap->newlib_used = mi.uordblks;
+}
+
+uint8_t heap_trace_get_sites(heap_trace_site_t * sites, uint8_t max) {
+
+	uint8_t n;
+
+	vTaskSuspendAll();
+	n = (sites_n_ < max) ? sites_n_ : max;
+	memcpy(sites, sites_, n * sizeof(heap_trace_site_t));
+	xTaskResumeAll();
+	return n;
+}
+
+/* Copia los ultimos eventos, del mas viejo al mas nuevo. */
+uint8_t heap_trace_get_events(heap_trace_event_t * events, uint8_t max) {
+
+#if 0 < HEAP_TRACE_CONFIG_RING_LEN
+	uint8_t n;
+
+	vTaskSuspendAll();
+	uint32_t avail = (ring_count_ < HEAP_TRACE_CONFIG_RING_LEN) ? ring_count_ : HEAP_TRACE_CONFIG_RING_LEN;
+
+	n = (avail < max) ? (uint8_t)avail : max;
+
+	for(uint8_t i = 0; i < n; i++)
+		events[i] = ring_[(ring_count_ - n + i) % HEAP_TRACE_CONFIG_RING_LEN];
+	xTaskResumeAll();
+	return n;
+#else
+	(void)events; (void)max;
+	return 0;
+#endif
+}
+
+void heap_trace_dump(void) {
+
+	heap_trace_snapshot_t snap;
+	heap_trace_site_t sites[HEAP_TRACE_CONFIG_MAX_SITES];
+	uint8_t n;
+
+	heap_trace_snapshot(&snap);
+	LOGGER_INFO("[HEAP] alloc %lu free %lu fail %lu vivo %lu pico %lu", (unsigned long)snap.allocs,
+				(unsigned long)snap.frees, (unsigned long)snap.failed, (unsigned long)snap.live_bytes,
+				(unsigned long)snap.peak_live_bytes);
+	LOGGER_INFO("[HEAP] libre %u min %u bloques %u mayor %u frag %u%%", (unsigned)snap.free_bytes,
+				(unsigned)snap.min_ever_free_bytes, (unsigned)snap.free_blocks,
+				(unsigned)snap.largest_free_block, snap.fragmentation_pct);
+	LOGGER_INFO("[HEAP] newlib arena %u usado %u", (unsigned)snap.newlib_arena, (unsigned)snap.newlib_used);
+
+	for(uint8_t i = 0; i < HEAP_TRACE_CONFIG_HIST_BINS; i++) {
+
+		if(snap.alloc_hist[i]) {
+
+			LOGGER_INFO("[HEAP] <=%u B: %lu", (unsigned)(1u << (HIST_MIN_SHIFT_ + i)), (unsigned long)snap.alloc_hist[i]);
+		}
+	}
+	n = heap_trace_get_sites(sites, HEAP_TRACE_CONFIG_MAX_SITES);
+
+	for(uint8_t i = 0; i < n; i++) {
+
+		LOGGER_INFO("[HEAP] sitio %p: a %lu f %lu vivo %lu", sites[i].site, (unsigned long)sites[i].allocs,
+					(unsigned long)sites[i].frees, (unsigned long)sites[i].live_bytes);
+	}
+	ring_dump_();
+}
+
+/********************** end of file ******************************************/
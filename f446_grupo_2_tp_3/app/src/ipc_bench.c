@@ -0,0 +1,389 @@
+/*
+ * ipc_bench.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "logger.h"
+#include "dwt.h"
+
+#include "app.h"
+#include "task_monitor.h"
+#include "ipc_bench.h"
+
+#if 1 == IPC_BENCH_CONFIG_ENABLE
+
+/********************** macros and definitions *******************************/
+#define N_                      (IPC_BENCH_ITERATIONS)
+#define DEPTH_                  (IPC_BENCH_DEPTH)
+#define MAX_                    (IPC_BENCH_MAX_PAYLOAD)
+#define SB_STORAGE_             (DEPTH_ * (MAX_ + sizeof(size_t)) + 1)
+
+/* dir 0: control -> eco; dir 1: eco -> control */
+#define DIR_PING_               (0)
+#define DIR_PONG_               (1)
+
+#define PAYLOAD_N_              (4)
+#define PL_(i)                  (1u << (i))		/* bit de payload_size_[i] */
+#define PL_DATA_                (PL_(1) | PL_(2) | PL_(3))
+
+typedef struct {
+
+	const char * name;
+	void (*open)(uint16_t size);
+	void (*send)(uint8_t dir, const uint8_t * buf, uint16_t size);
+	void (*recv)(uint8_t dir, uint8_t * buf, uint16_t size);
+	void (*close)(void);
+	uint8_t payloads;			/* PL_(i) de los tamanos admitidos */
+	uint8_t buffered;			/* PL_(i) donde caben DEPTH_ mensajes en vuelo */
+} prim_t;
+
+typedef enum {
+
+	MODE_PINGPONG_,
+	MODE_STREAM_,
+} bench_mode_t;
+
+/********************** internal functions declaration ***********************/
+static void q_open_(uint16_t size);
+static void q_send_(uint8_t dir, const uint8_t * buf, uint16_t size);
+static void q_recv_(uint8_t dir, uint8_t * buf, uint16_t size);
+static void q_close_(void);
+static void n_open_(uint16_t size);
+static void n_send_(uint8_t dir, const uint8_t * buf, uint16_t size);
+static void n_recv_(uint8_t dir, uint8_t * buf, uint16_t size);
+static void n_close_(void);
+static void sb_open_(uint16_t size);
+static void sb_send_(uint8_t dir, const uint8_t * buf, uint16_t size);
+static void sb_recv_(uint8_t dir, uint8_t * buf, uint16_t size);
+static void mb_open_(uint16_t size);
+static void mb_send_(uint8_t dir, const uint8_t * buf, uint16_t size);
+static void mb_recv_(uint8_t dir, uint8_t * buf, uint16_t size);
+static void sb_close_(void);
+static void sem_open_(uint16_t size);
+static void sem_send_(uint8_t dir, const uint8_t * buf, uint16_t size);
+static void sem_recv_(uint8_t dir, uint8_t * buf, uint16_t size);
+static void sem_close_(void);
+static void eg_open_(uint16_t size);
+static void eg_send_(uint8_t dir, const uint8_t * buf, uint16_t size);
+static void eg_recv_(uint8_t dir, uint8_t * buf, uint16_t size);
+static void eg_close_(void);
+
+/********************** internal data definition *****************************/
+static const uint16_t payload_size_[PAYLOAD_N_] = {0, 4, 16, 64};
+static const char * const rel_name_[] = {"hi", "eq", "lo"};
+static const UBaseType_t rel_prio_[] = {IPC_BENCH_PRIORITY + 1, IPC_BENCH_PRIORITY, IPC_BENCH_PRIORITY - 1};
+
+static const prim_t prims_[] = {
+
+	{"queue",  q_open_,   q_send_,   q_recv_,   q_close_,   PL_DATA_,          PL_DATA_},
+	{"notify", n_open_,   n_send_,   n_recv_,   n_close_,   PL_(0) | PL_(1),   PL_(0)},
+	{"stream", sb_open_,  sb_send_,  sb_recv_,  sb_close_,  PL_DATA_,          PL_DATA_},
+	{"msgbuf", mb_open_,  mb_send_,  mb_recv_,  sb_close_,  PL_DATA_,          PL_DATA_},
+	{"sem",    sem_open_, sem_send_, sem_recv_, sem_close_, PL_(0),            PL_(0)},
+	{"evgroup", eg_open_, eg_send_,  eg_recv_,  eg_close_,  PL_(0),            0},
+};
+
+/* objetos estaticos: se recrean en cada caso con el tamano que corresponda */
+static QueueHandle_t q_[2];
+static StaticQueue_t q_ctrl_[2];
+static uint8_t q_storage_[2][DEPTH_ * MAX_];
+static StreamBufferHandle_t sb_[2];
+static StaticStreamBuffer_t sb_ctrl_[2];
+static uint8_t sb_storage_[2][SB_STORAGE_];
+static SemaphoreHandle_t sem_[2];
+static StaticSemaphore_t sem_ctrl_[2];
+static EventGroupHandle_t eg_;
+static StaticEventGroup_t eg_ctrl_;
+
+static TaskHandle_t task_[2];			/* [DIR_PING_] eco, [DIR_PONG_] control: destino de cada dir */
+static SemaphoreHandle_t go_;
+static SemaphoreHandle_t done_;
+static StaticSemaphore_t go_ctrl_;
+static StaticSemaphore_t done_ctrl_;
+static StaticTask_t ctrl_tcb_;
+static StackType_t ctrl_stack_[IPC_BENCH_STACK_SIZE];
+static StaticTask_t echo_tcb_;
+static StackType_t echo_stack_[IPC_BENCH_STACK_SIZE];
+
+static const prim_t * cur_;
+static uint16_t cur_size_;
+static bench_mode_t mode_;
+static volatile uint32_t stamp_;		/* CYCCNT justo antes de cada envio de ping */
+static uint32_t oneway_total_;
+
+/********************** internal functions definition ************************/
+/* cola */
+static void q_open_(uint16_t size) {
+
+	for(uint8_t d = 0; d < 2; d++)
+		q_[d] = xQueueCreateStatic(DEPTH_, size, q_storage_[d], &q_ctrl_[d]);
+}
+
+static void q_send_(uint8_t dir, const uint8_t * buf, uint16_t size) {
+
+	xQueueSend(q_[dir], buf, portMAX_DELAY);
+}
+
+static void q_recv_(uint8_t dir, uint8_t * buf, uint16_t size) {
+
+	xQueueReceive(q_[dir], buf, portMAX_DELAY);
+}
+
+static void q_close_(void) {
+
+	vQueueDelete(q_[0]);
+	vQueueDelete(q_[1]);
+}
+
+/* notificacion: sin payload cuenta (give/take), con 4 B sobrescribe el valor */
+static void n_open_(uint16_t size) {
+
+	(void)size;
+}
+
+static void n_send_(uint8_t dir, const uint8_t * buf, uint16_t size) {
+
+	uint32_t value;
+
+	if(0 == size) {
+
+		xTaskNotifyGive(task_[dir]);
+	} else {
+
+		memcpy(&value, buf, sizeof(value));
+		xTaskNotify(task_[dir], value, eSetValueWithOverwrite);
+	}
+}
+
+static void n_recv_(uint8_t dir, uint8_t * buf, uint16_t size) {
+
+	uint32_t value;
+
+	if(0 == size) {
+
+		ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+	} else {
+
+		xTaskNotifyWait(0, 0, &value, portMAX_DELAY);
+		memcpy(buf, &value, sizeof(value));
+	}
+}
+
+static void n_close_(void) {
+}
+
+/* stream buffer: disparo en un mensaje completo */
+static void sb_open_(uint16_t size) {
+
+	for(uint8_t d = 0; d < 2; d++)
+		sb_[d] = xStreamBufferCreateStatic(DEPTH_ * size, size, sb_storage_[d], &sb_ctrl_[d]);
+}
+
+static void sb_send_(uint8_t dir, const uint8_t * buf, uint16_t size) {
+
+	xStreamBufferSend(sb_[dir], buf, size, portMAX_DELAY);
+}
+
+static void sb_recv_(uint8_t dir, uint8_t * buf, uint16_t size) {
+
+	size_t got = 0;
+
+	while(got < size)
+		got += xStreamBufferReceive(sb_[dir], &buf[got], size - got, portMAX_DELAY);
+}
+
+/* message buffer: cada mensaje lleva su largo (size_t) en el buffer */
+static void mb_open_(uint16_t size) {
+
+	for(uint8_t d = 0; d < 2; d++)
+		sb_[d] = xMessageBufferCreateStatic(DEPTH_ * (size + sizeof(size_t)), sb_storage_[d], &sb_ctrl_[d]);
+}
+
+static void mb_send_(uint8_t dir, const uint8_t * buf, uint16_t size) {
+
+	xMessageBufferSend(sb_[dir], buf, size, portMAX_DELAY);
+}
+
+static void mb_recv_(uint8_t dir, uint8_t * buf, uint16_t size) {
+
+	xMessageBufferReceive(sb_[dir], buf, MAX_, portMAX_DELAY);
+}
+
+static void sb_close_(void) {
+
+	vStreamBufferDelete(sb_[0]);
+	vStreamBufferDelete(sb_[1]);
+}
+
+/* semaforo contador: el tope cubre una rafaga entera */
+static void sem_open_(uint16_t size) {
+
+	for(uint8_t d = 0; d < 2; d++)
+		sem_[d] = xSemaphoreCreateCountingStatic(N_, 0, &sem_ctrl_[d]);
+}
+
+static void sem_send_(uint8_t dir, const uint8_t * buf, uint16_t size) {
+
+	xSemaphoreGive(sem_[dir]);
+}
+
+static void sem_recv_(uint8_t dir, uint8_t * buf, uint16_t size) {
+
+	xSemaphoreTake(sem_[dir], portMAX_DELAY);
+}
+
+static void sem_close_(void) {
+
+	vSemaphoreDelete(sem_[0]);
+	vSemaphoreDelete(sem_[1]);
+}
+
+/* event group: un bit por direccion, se limpia al salir de la espera */
+static void eg_open_(uint16_t size) {
+
+	eg_ = xEventGroupCreateStatic(&eg_ctrl_);
+}
+
+static void eg_send_(uint8_t dir, const uint8_t * buf, uint16_t size) {
+
+	xEventGroupSetBits(eg_, 1u << dir);
+}
+
+static void eg_recv_(uint8_t dir, uint8_t * buf, uint16_t size) {
+
+	xEventGroupWaitBits(eg_, 1u << dir, pdTRUE, pdTRUE, portMAX_DELAY);
+}
+
+static void eg_close_(void) {
+
+	vEventGroupDelete(eg_);
+}
+
+static void task_echo_(void * argument) {
+
+	uint8_t buf[MAX_];
+
+	while(true) {
+
+		xSemaphoreTake(go_, portMAX_DELAY);
+
+		if(MODE_PINGPONG_ == mode_) {
+
+			for(uint16_t i = 0; i < N_; i++) {
+
+				cur_->recv(DIR_PING_, buf, cur_size_);
+				oneway_total_ += cycle_counter_get() - stamp_;
+				cur_->send(DIR_PONG_, buf, cur_size_);
+			}
+		} else {
+
+			for(uint16_t i = 0; i < N_; i++)
+				cur_->recv(DIR_PING_, buf, cur_size_);
+			cur_->send(DIR_PONG_, buf, cur_size_);
+		}
+		xSemaphoreGive(done_);
+	}
+}
+
+static void run_case_(const prim_t * prim, uint8_t pl, uint8_t rel) {
+
+	uint8_t buf[MAX_];
+	uint32_t rtt_total = 0;
+	uint32_t msg_s = 0;
+	uint32_t t0;
+
+	memset(buf, 0xA5, sizeof(buf));
+	cur_ = prim;
+	cur_size_ = payload_size_[pl];
+	oneway_total_ = 0;
+	vTaskPrioritySet(task_[DIR_PING_], rel_prio_[rel]);
+	prim->open(cur_size_);
+
+	mode_ = MODE_PINGPONG_;
+	xSemaphoreGive(go_);
+
+	for(uint16_t i = 0; i < N_; i++) {
+
+		stamp_ = cycle_counter_get();
+		prim->send(DIR_PING_, buf, cur_size_);
+		prim->recv(DIR_PONG_, buf, cur_size_);
+		rtt_total += cycle_counter_get() - stamp_;
+	}
+	xSemaphoreTake(done_, portMAX_DELAY);
+
+	if(0 != (prim->buffered & PL_(pl))) {
+
+		mode_ = MODE_STREAM_;
+		xSemaphoreGive(go_);
+		t0 = cycle_counter_get();
+
+		for(uint16_t i = 0; i < N_; i++)
+			prim->send(DIR_PING_, buf, cur_size_);
+		prim->recv(DIR_PONG_, buf, cur_size_);
+		msg_s = (uint32_t)(((uint64_t)N_ * SystemCoreClock) / (cycle_counter_get() - t0));
+		xSemaphoreTake(done_, portMAX_DELAY);
+	}
+	prim->close();
+
+	LOGGER_LOG("ipc,%s,%u,%s,%lu,%lu,%lu\n", prim->name, cur_size_, rel_name_[rel],
+			   (unsigned long)(rtt_total / N_), (unsigned long)(oneway_total_ / N_), (unsigned long)msg_s);
+}
+
+static void task_ctrl_(void * argument) {
+
+	cycle_counter_init();
+	LOGGER_INFO("[IPC] %u iteraciones, %lu Hz", N_, (unsigned long)SystemCoreClock);
+	LOGGER_LOG("ipc,prim,bytes,rx,rtt,oneway,msg_s\n");
+
+	for(uint8_t p = 0; p < sizeof(prims_) / sizeof(prims_[0]); p++) {
+
+		for(uint8_t pl = 0; pl < PAYLOAD_N_; pl++) {
+
+			if(0 == (prims_[p].payloads & PL_(pl)))
+				continue;
+
+			for(uint8_t rel = 0; rel < sizeof(rel_prio_) / sizeof(rel_prio_[0]); rel++)
+				run_case_(&prims_[p], pl, rel);
+		}
+	}
+	LOGGER_INFO("[IPC] fin");
+	vTaskSuspend(NULL);
+}
+
+/********************** external functions definition ************************/
+bool ipc_bench_init(void) {
+
+	go_ = xSemaphoreCreateBinaryStatic(&go_ctrl_);
+	done_ = xSemaphoreCreateBinaryStatic(&done_ctrl_);
+	task_[DIR_PING_] = xTaskCreateStatic(task_echo_, "ipc_echo", IPC_BENCH_STACK_SIZE, NULL, IPC_BENCH_PRIORITY,
+										 echo_stack_, &echo_tcb_);
+	task_[DIR_PONG_] = xTaskCreateStatic(task_ctrl_, "ipc_ctrl", IPC_BENCH_STACK_SIZE, NULL, IPC_BENCH_PRIORITY,
+										 ctrl_stack_, &ctrl_tcb_);
+
+	if(NULL == go_ || NULL == done_ || NULL == task_[DIR_PING_] || NULL == task_[DIR_PONG_]) {
+
+		LOGGER_INFO("[IPC] error en ipc_bench_init().");
+		return false;
+	}
+	task_monitor_register(task_[DIR_PING_], IPC_BENCH_STACK_SIZE);
+	task_monitor_register(task_[DIR_PONG_], IPC_BENCH_STACK_SIZE);
+	app_static_report("ipc_bench", sizeof(q_storage_) + sizeof(sb_storage_) + sizeof(ctrl_stack_) +
+					  sizeof(echo_stack_));
+	return true;
+}
+
+#endif
+
+/********************** end of file ******************************************/
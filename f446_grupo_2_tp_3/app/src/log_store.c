@@ -0,0 +1,277 @@
+/*
+ * log_store.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "crc16.h"
+#include "log_store.h"
+
+/********************** macros and definitions *******************************/
+#define SECTOR_MAGIC_           (0x31474C46u)	/* "FLG1" */
+#define PAGE_MAGIC_             (0x474Cu)
+#define MAX_SECTORS_            (4)
+#define ERASED_WORD_            (0xFFFFFFFFu)
+
+typedef struct {
+
+	uint32_t magic;
+	uint32_t seq;				/* crece con cada sector que se abre */
+	uint32_t erase_count;
+	uint32_t crc;				/* CRC16 de los campos anteriores */
+} sector_hdr_t;
+
+typedef struct {
+
+	uint16_t magic;
+	uint16_t used;
+	uint16_t crc;				/* CRC16 de los used bytes de datos */
+	uint16_t reserved;
+} page_hdr_t;
+
+/********************** internal data definition *****************************/
+static bool mounted_;
+static uint8_t sectors_;
+static uint8_t active_;
+static uint32_t seq_;
+static uint32_t erase_count_;
+static uint32_t head_;
+
+/********************** internal functions definition ************************/
+static uint32_t pages_(uint8_t sector) {
+
+	return log_store_hw_size(sector) / LOG_STORE_PAGE_SIZE;
+}
+
+static const uint8_t * page_(uint8_t sector, uint32_t page) {
+
+	return log_store_hw_base(sector) + page * LOG_STORE_PAGE_SIZE;
+}
+
+static bool page_erased_(uint8_t sector, uint32_t page) {
+
+	uint32_t w;
+
+	memcpy(&w, page_(sector, page), sizeof(w));
+	return (ERASED_WORD_ == w);
+}
+
+static bool sector_hdr_(uint8_t sector, sector_hdr_t * hdr) {
+
+	memcpy(hdr, log_store_hw_base(sector), sizeof(*hdr));
+	return (SECTOR_MAGIC_ == hdr->magic &&
+			crc16_update(CRC16_INIT, (const uint8_t *)hdr, offsetof(sector_hdr_t, crc)) == hdr->crc);
+}
+
+/* Borra el sector y lo abre como activo con la secuencia seq. */
+static bool open_sector_(uint8_t sector, uint32_t seq) {
+
+	sector_hdr_t hdr;
+	uint32_t erase_count = sector_hdr_(sector, &hdr) ? hdr.erase_count : 0;
+
+	if(!log_store_hw_erase(sector))
+		return false;
+
+	hdr.magic = SECTOR_MAGIC_;
+	hdr.seq = seq;
+	hdr.erase_count = erase_count + 1;
+	hdr.crc = crc16_update(CRC16_INIT, (const uint8_t *)&hdr, offsetof(sector_hdr_t, crc));
+
+	if(!log_store_hw_program(sector, 0, (const uint8_t *)&hdr, sizeof(hdr)))
+		return false;
+
+	active_ = sector;
+	seq_ = seq;
+	erase_count_ = hdr.erase_count;
+	head_ = 1;
+	return true;
+}
+
+static bool page_valid_(const page_hdr_t * hdr, const uint8_t * data) {
+
+	return (PAGE_MAGIC_ == hdr->magic && LOG_STORE_PAGE_DATA_SIZE >= hdr->used &&
+			crc16_update(CRC16_INIT, data, hdr->used) == hdr->crc);
+}
+
+/* Datos de la proxima pagina valida desde el cursor, que queda despues de ella;
+ * NULL al final. Los sectores van por secuencia, el de menor seq no anterior
+ * al cursor; uno que ya no esta (se borro al rotar) se reemplaza por el mas
+ * viejo que quede, desde su primera pagina. */
+static const uint8_t * next_page_(log_store_cursor_t * cur, page_hdr_t * ph) {
+
+	sector_hdr_t hdr;
+
+	for(;;) {
+
+		bool found = false;
+		uint8_t s = 0;
+		uint32_t seq = 0;
+		uint32_t end;
+
+		for(uint8_t i = 0; i < sectors_; i++) {
+
+			if(sector_hdr_(i, &hdr) && hdr.seq >= cur->seq && (!found || hdr.seq < seq)) {
+
+				found = true;
+				s = i;
+				seq = hdr.seq;
+			}
+		}
+
+		if(!found)
+			return NULL;
+
+		if(seq != cur->seq || 0 == cur->page) {
+
+			cur->seq = seq;
+			cur->page = 1;
+		}
+
+		end = (s == active_) ? head_ : pages_(s);
+		while(cur->page < end && !page_erased_(s, cur->page)) {
+
+			const uint8_t * p = page_(s, cur->page++);
+
+			memcpy(ph, p, sizeof(*ph));
+			if(page_valid_(ph, p + sizeof(*ph)))
+				return p + sizeof(*ph);
+		}
+
+		cur->seq = seq + 1;
+		cur->page = 1;
+	}
+}
+
+/********************** external functions definition ************************/
+/* Solo encabezados: uno por sector y log2(paginas) paginas del sector activo. */
+bool log_store_mount(void) {
+
+	sector_hdr_t hdr;
+	bool found = false;
+	uint32_t lo;
+	uint32_t hi;
+
+	mounted_ = false;
+	sectors_ = log_store_hw_sectors();
+
+	if(0 == sectors_ || MAX_SECTORS_ < sectors_)
+		return false;
+
+	for(uint8_t s = 0; s < sectors_; s++) {
+
+		if(sector_hdr_(s, &hdr) && (!found || hdr.seq > seq_)) {
+
+			found = true;
+			active_ = s;
+			seq_ = hdr.seq;
+			erase_count_ = hdr.erase_count;
+		}
+	}
+
+	if(!found) {
+
+		mounted_ = open_sector_(0, 1);
+		return mounted_;
+	}
+
+	/* las paginas se escriben en orden: la primera borrada es la cabeza */
+	lo = 1;
+	hi = pages_(active_);
+	while(lo < hi) {
+
+		uint32_t mid = lo + (hi - lo) / 2;
+
+		if(page_erased_(active_, mid))
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	head_ = lo;
+	mounted_ = true;
+	return true;
+}
+
+/* Graba una pagina con data[0, used). data tiene que poder leerse hasta used
+ * redondeado a 4. La pagina queda ocupada aunque la escritura falle, salvo que
+ * el encabezado no se haya llegado a programar. */
+bool log_store_write(const uint8_t * data, uint16_t used) {
+
+	static const page_hdr_t retired = {0};
+	page_hdr_t hdr;
+	uint32_t offset;
+
+	if(!mounted_ || LOG_STORE_PAGE_DATA_SIZE < used)
+		return false;
+
+	if(pages_(active_) <= head_ && !open_sector_((uint8_t)((active_ + 1) % sectors_), seq_ + 1))
+		return false;
+
+	hdr.magic = PAGE_MAGIC_;
+	hdr.used = used;
+	hdr.crc = crc16_update(CRC16_INIT, data, used);
+	hdr.reserved = 0xFFFF;
+	offset = head_ * LOG_STORE_PAGE_SIZE;
+
+	if(!log_store_hw_program(active_, offset, (const uint8_t *)&hdr, sizeof(hdr))) {
+
+		/* Una pagina borrada detras de la cabeza cortaria el montaje (busqueda
+		 * binaria) y el recorrido, y se perderia todo lo grabado despues: se la
+		 * retira con el encabezado en cero (bajar bits ya programados es
+		 * valido) y, si sigue borrada, la proxima escritura la reusa. */
+		log_store_hw_program(active_, offset, (const uint8_t *)&retired, sizeof(retired));
+		if(!page_erased_(active_, head_))
+			head_++;
+		return false;
+	}
+	head_++;
+
+	return (0 == used || log_store_hw_program(active_, offset + sizeof(hdr), data, (used + 3u) & ~3u));
+}
+
+/* Paginas validas de la mas vieja a la mas nueva; las danadas se saltean. */
+void log_store_foreach(log_store_page_cb_t cb, void * ctx) {
+
+	log_store_cursor_t cur = {0, 0};
+	page_hdr_t ph;
+	const uint8_t * data;
+
+	if(!mounted_)
+		return;
+
+	while(NULL != (data = next_page_(&cur, &ph)) && cb(data, ph.used, ctx))
+		;
+}
+
+/* Copia en data (LOG_STORE_PAGE_DATA_SIZE bytes) la proxima pagina valida y
+ * avanza el cursor. Devuelve false al final. */
+bool log_store_read(log_store_cursor_t * cur, uint8_t * data, uint16_t * used) {
+
+	page_hdr_t ph;
+	const uint8_t * src;
+
+	if(!mounted_ || NULL == (src = next_page_(cur, &ph)))
+		return false;
+
+	memcpy(data, src, ph.used);
+	*used = ph.used;
+	return true;
+}
+
+void log_store_get_info(log_store_info_t * info) {
+
+	info->sectors = sectors_;
+	info->active = active_;
+	info->seq = seq_;
+	info->erase_count = erase_count_;
+	info->head_page = head_;
+	info->pages_per_sector = mounted_ ? pages_(active_) : 0;
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,92 @@
+/*
+ * log_store_hw.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+
+#include "log_store.h"
+
+/********************** macros and definitions *******************************/
+typedef struct {
+
+	uint32_t sector;			/* FLASH_SECTOR_x */
+	uint32_t addr;
+	uint32_t size;
+} hw_sector_t;
+
+/********************** internal data definition *****************************/
+/* Reservados en el linker. Un solo banco: programar o borrar detiene la CPU.
+ * Con dos sectores, al rotar se borra el mas viejo y el otro queda completo. */
+static const hw_sector_t sectors_[] = {
+
+	{FLASH_SECTOR_6, 0x08040000u, 128u * 1024u},
+	{FLASH_SECTOR_7, 0x08060000u, 128u * 1024u},
+};
+
+/********************** internal functions definition ************************/
+static void unlock_(void) {
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+						   FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+}
+
+/********************** external functions definition ************************/
+uint8_t log_store_hw_sectors(void) {
+
+	return sizeof(sectors_) / sizeof(sectors_[0]);
+}
+
+const uint8_t * log_store_hw_base(uint8_t sector) {
+
+	return (const uint8_t *)(uintptr_t)sectors_[sector].addr;
+}
+
+uint32_t log_store_hw_size(uint8_t sector) {
+
+	return sectors_[sector].size;
+}
+
+bool log_store_hw_erase(uint8_t sector) {
+
+	FLASH_EraseInitTypeDef erase = {0};
+	uint32_t sector_error = 0;
+	bool ok;
+
+	erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+	erase.Sector = sectors_[sector].sector;
+	erase.NbSectors = 1;
+	erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+	unlock_();
+	ok = (HAL_OK == HAL_FLASHEx_Erase(&erase, &sector_error));
+	HAL_FLASH_Lock();
+	return ok;
+}
+
+bool log_store_hw_program(uint8_t sector, uint32_t offset, const uint8_t * data, uint32_t len) {
+
+	uint32_t addr = sectors_[sector].addr + offset;
+	bool ok = true;
+
+	unlock_();
+	for(uint32_t i = 0; ok && i < len; i += sizeof(uint32_t)) {
+
+		uint32_t w;
+
+		memcpy(&w, &data[i], sizeof(w));		/* data puede no estar alineado */
+		ok = (HAL_OK == HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + i, w));
+	}
+	HAL_FLASH_Lock();
+	return ok;
+}
+
+/********************** end of file ******************************************/
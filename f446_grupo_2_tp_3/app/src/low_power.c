@@ -0,0 +1,106 @@
+/*
+ * low_power.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+
+#include "cpu_load.h"
+#include "stress_test.h"
+#include "low_power.h"
+
+/********************** macros and definitions *******************************/
+#define CYCLES_PER_TICK_        (SystemCoreClock / configTICK_RATE_HZ)
+#define HAL_TICK_SUSPEND_       (0 == STRESS_TEST_CONFIG_ENABLE)	/* la prueba usa la IRQ de TIM1 como carga */
+
+/********************** internal data definition *****************************/
+extern TIM_HandleTypeDef htim1;
+
+static low_power_stats_t stats_;
+static uint32_t sleep_reload_;			/* cuentas de SysTick programadas para este sueno */
+#if HAL_TICK_SUSPEND_
+static uint32_t tim_cnt_pre_;			/* contador de TIM1 (1 MHz) al dormir */
+#endif
+
+/********************** internal functions definition ************************/
+#if HAL_TICK_SUSPEND_
+/* TIM1 sigue contando con su IRQ enmascarada: las vueltas que dio mientras se
+ * dormia son los ms que le faltan a uwTick. La primera queda en UIF y la atiende
+ * la IRQ al reanudar; el resto se suma aca. */
+static void hal_tick_catch_up_(uint32_t slept_cycles) {
+
+	int32_t period = (int32_t)__HAL_TIM_GET_AUTORELOAD(&htim1) + 1;
+	int32_t us = (int32_t)(slept_cycles / (SystemCoreClock / 1000000u));
+	int32_t cnt_post = (int32_t)__HAL_TIM_GET_COUNTER(&htim1);
+	int32_t wraps = ((int32_t)tim_cnt_pre_ + us - cnt_post + period / 2) / period;
+
+	if(1 < wraps)
+		uwTick += (uint32_t)(wraps - 1) * uwTickFreq;
+}
+#endif
+
+/********************** external functions definition ************************/
+/* Llamado por configPRE_SLEEP_PROCESSING con SysTick ya reprogramado y en 0. */
+void low_power_pre_sleep(uint32_t * idle_ticks) {
+
+	stats_.sleeps++;
+	stats_.requested_ticks += *idle_ticks;
+	sleep_reload_ = SysTick->LOAD;
+#if HAL_TICK_SUSPEND_
+	tim_cnt_pre_ = __HAL_TIM_GET_COUNTER(&htim1);
+	HAL_SuspendTick();
+#endif
+}
+
+/* Llamado por configPOST_SLEEP_PROCESSING, antes de que el kernel lea
+ * SysTick->CTRL: no se toca COUNTFLAG. Si el plazo vencio, la IRQ de SysTick
+ * queda pendiente (ICSR.PENDSTSET) y se durmio el plazo completo. */
+void low_power_post_sleep(uint32_t expected_ticks) {
+
+	uint32_t slept;
+
+	(void)expected_ticks;
+
+	if(0 != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) {
+
+		slept = sleep_reload_ + 1;
+	} else {
+
+		slept = sleep_reload_ - SysTick->VAL;
+		stats_.early_wakeups++;
+	}
+#if HAL_TICK_SUSPEND_
+	hal_tick_catch_up_(slept);
+	HAL_ResumeTick();
+#endif
+	stats_.slept_cycles += slept;
+#if 1 == CPU_LOAD_CONFIG_ENABLE
+	cpu_load_credit_idle(slept);
+#endif
+}
+
+void low_power_get_stats(low_power_stats_t * stats) {
+
+	uint64_t total;
+	uint32_t seconds;
+
+	taskENTER_CRITICAL();
+	*stats = stats_;
+	taskEXIT_CRITICAL();
+
+	total = (uint64_t)xTaskGetTickCount() * CYCLES_PER_TICK_;
+	seconds = xTaskGetTickCount() / configTICK_RATE_HZ;
+
+	stats->residency_pm = (0 == total) ? 0 : (uint16_t)((stats->slept_cycles * 1000) / total);
+	stats->wakeups_per_s = (0 == seconds) ? 0 : (uint16_t)(stats->sleeps / seconds);
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,201 @@
+/*
+ * mem_pool.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+
+#include "mem_pool.h"
+
+#if 1 == MEM_POOL_CONFIG_ENABLE
+
+/********************** macros and definitions *******************************/
+#define POOL_ALIGN_                  (8)
+#define CLASS_SIZE_(size, blocks)    (size),
+#define CLASS_BLOCKS_(size, blocks)  (blocks),
+#define CLASS_BYTES_(size, blocks)   + (size) * (blocks)
+#define ARENA_BYTES_                 (0 MEM_POOL_CLASSES(CLASS_BYTES_))
+
+typedef union block_t {
+
+	union block_t * next;		/* solo mientras el bloque esta libre */
+	uint64_t align_;
+} block_t;
+
+typedef struct {
+
+	uint8_t * base;
+	uint8_t * end;
+	block_t * free_list;
+	mem_pool_stats_t stats;
+} pool_class_t;
+
+/********************** internal data definition *****************************/
+static const uint16_t class_sizes_[MEM_POOL_CLASS_N] = { MEM_POOL_CLASSES(CLASS_SIZE_) };
+static const uint16_t class_blocks_[MEM_POOL_CLASS_N] = { MEM_POOL_CLASSES(CLASS_BLOCKS_) };
+static uint8_t arena_[ARENA_BYTES_] __attribute__((aligned(POOL_ALIGN_)));
+static pool_class_t classes_[MEM_POOL_CLASS_N];
+static bool pool_initialized_ = false;
+
+/********************** internal functions declaration ***********************/
+static pool_class_t * class_of_(const void * ptr);
+
+/********************** internal functions definition ************************/
+static pool_class_t * class_of_(const void * ptr) {
+
+	const uint8_t * p = (const uint8_t *)ptr;
+
+	for(uint8_t i = 0; i < MEM_POOL_CLASS_N; i++) {
+
+		if(p >= classes_[i].base && p < classes_[i].end)
+			return &classes_[i];
+	}
+	return NULL;
+}
+
+/********************** external functions definition ************************/
+void mem_pool_init(void) {
+
+	uint8_t * cursor = arena_;
+
+	if(pool_initialized_)
+		return;
+
+	for(uint8_t i = 0; i < MEM_POOL_CLASS_N; i++) {
+
+		pool_class_t * c = &classes_[i];
+
+		configASSERT(0 == (class_sizes_[i] % POOL_ALIGN_));
+		configASSERT(0 == i || class_sizes_[i] > class_sizes_[i - 1]);
+		c->base = cursor;
+		c->free_list = NULL;
+
+		/* se enlazan de atras hacia adelante: el primer alloc toma el bloque mas bajo */
+		for(uint16_t b = class_blocks_[i]; b > 0; b--) {
+
+			block_t * blk = (block_t *)(cursor + (uint32_t)(b - 1) * class_sizes_[i]);
+
+			blk->next = c->free_list;
+			c->free_list = blk;
+		}
+		cursor += (uint32_t)class_blocks_[i] * class_sizes_[i];
+		c->end = cursor;
+
+		memset(&c->stats, 0, sizeof(c->stats));
+		c->stats.block_size = class_sizes_[i];
+		c->stats.blocks = class_blocks_[i];
+	}
+	configASSERT(cursor == arena_ + ARENA_BYTES_);
+	pool_initialized_ = true;
+}
+
+void * mem_pool_alloc(size_t size) {
+
+	block_t * blk = NULL;
+	uint8_t first = 0;
+
+	if(0 == size || !pool_initialized_)
+		return NULL;
+
+	while(first < MEM_POOL_CLASS_N && size > class_sizes_[first])
+		first++;
+
+	if(MEM_POOL_CLASS_N == first)
+		return NULL;
+
+	taskENTER_CRITICAL();
+
+	for(uint8_t i = first; i < MEM_POOL_CLASS_N; i++) {
+
+		pool_class_t * c = &classes_[i];
+
+		blk = c->free_list;
+
+		if(NULL != blk) {
+
+			c->free_list = blk->next;
+			c->stats.allocs++;
+
+			if(++c->stats.used > c->stats.peak)
+				c->stats.peak = c->stats.used;
+
+			if(i != first)
+				c->stats.spills++;
+			break;
+		}
+		c->stats.fails++;
+#if 0 == MEM_POOL_CONFIG_SPILL
+		break;
+#endif
+	}
+	taskEXIT_CRITICAL();
+	return blk;
+}
+
+void mem_pool_free(void * ptr) {
+
+	if(NULL == ptr)
+		return;
+
+	pool_class_t * c = class_of_(ptr);
+
+	/* puntero ajeno o desalineado dentro de la clase: error del llamador */
+	configASSERT(NULL != c);
+	configASSERT(0 == ((uint32_t)((uint8_t *)ptr - c->base) % c->stats.block_size));
+
+	if(NULL == c)
+		return;
+
+	taskENTER_CRITICAL();
+	((block_t *)ptr)->next = c->free_list;
+	c->free_list = (block_t *)ptr;
+	c->stats.used--;
+	taskEXIT_CRITICAL();
+}
+
+bool mem_pool_owns(const void * ptr) {
+
+	return NULL != class_of_(ptr);
+}
+
+bool mem_pool_get_stats(uint8_t cls, mem_pool_stats_t * stats) {
+
+	if(MEM_POOL_CLASS_N <= cls || NULL == stats)
+		return false;
+
+	taskENTER_CRITICAL();
+	*stats = classes_[cls].stats;
+	taskEXIT_CRITICAL();
+	return true;
+}
+
+size_t mem_pool_static_size(void) {
+
+	return sizeof(arena_) + sizeof(classes_);
+}
+
+void mem_pool_dump(void) {
+
+	mem_pool_stats_t s;
+
+	for(uint8_t i = 0; i < MEM_POOL_CLASS_N; i++) {
+
+		mem_pool_get_stats(i, &s);
+		LOGGER_INFO("[POOL] %u B: %u/%u pico %u fail %lu", s.block_size, s.used, s.blocks, s.peak,
+					(unsigned long)s.fails);
+	}
+}
+
+#endif
+
+/********************** end of file ******************************************/
@@ -0,0 +1,354 @@
+/*
+ * params.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+
+#include "app.h"
+#include "ao_ui.h"
+#include "ao_led.h"
+#include "priority_queue.h"
+#include "crc16.h"
+#include "params.h"
+
+/********************** macros and definitions *******************************/
+/* El largo va en el magic: un registro grabado con otra lista de parametros no se carga. */
+#define RECORD_MAGIC_           (0x50410000u | PARAM__N)
+#define RECORD_WORDS_           (sizeof(record_t) / sizeof(uint32_t))
+#define SLOTS_                  (PARAMS_CONFIG_FLASH_SIZE / sizeof(record_t))
+#define BANKS_                  (2)
+
+typedef struct {
+
+	uint32_t magic;
+	uint32_t seq;
+	uint32_t v[PARAM__N];
+	uint32_t crc;				/* CRC16 sobre seq y v, en los 16 bits bajos */
+} record_t;
+
+typedef struct {
+
+	uint32_t sector;			/* FLASH_SECTOR_x */
+	uint32_t addr;
+} bank_t;
+
+/********************** internal data definition *****************************/
+static const param_desc_t desc_[PARAM__N] = {
+
+	[PARAM_BTN_PERIOD_MS] = {"btn_period", 50,                        10,                        500,                   0},
+	[PARAM_BTN_PULSE_MS]  = {"btn_pulse",  200,                       50,                        10000,                 0},
+	[PARAM_BTN_SHORT_MS]  = {"btn_short",  1000,                      50,                        10000,                 0},
+	[PARAM_BTN_LONG_MS]   = {"btn_long",   2000,                      50,                        10000,                 0},
+	[PARAM_UI_PERIOD_MS]  = {"ui_period",  50,                        0,                         1000,                  0},
+	[PARAM_UI_QUEUE_LEN]  = {"ui_queue",   AO_UI_QUEUE_LENGTH,        1,                         AO_UI_QUEUE_LENGTH,    PARAM_F_BOOT},
+	[PARAM_PQ_MAX_LEN]    = {"pq_max",     PRIO_QUEUE_MAX_LENGTH,     2,                         PRIO_QUEUE_MAX_LENGTH, PARAM_F_BOOT},
+	[PARAM_LED_HOLD_MS]   = {"led_hold",   AO_LED_CONFIG_HOLD_MAX_MS, AO_LED_CONFIG_HOLD_MIN_MS, 60000,                 0},
+};
+
+static volatile uint32_t seq_;			/* impar: escritura en curso */
+static volatile uint32_t cur_[PARAM__N];
+#if 1 == PARAMS_CONFIG_PERSIST
+static const bank_t banks_[BANKS_] = {
+
+	{PARAMS_CONFIG_FLASH_SECTOR_A, PARAMS_CONFIG_FLASH_ADDR_A},
+	{PARAMS_CONFIG_FLASH_SECTOR_B, PARAMS_CONFIG_FLASH_ADDR_B},
+};
+static uint8_t bank_;					/* sector en uso */
+static uint32_t slot_next_;				/* lugar siguiente al ultimo grabado de bank_ */
+static uint32_t saved_seq_;
+static params_t saved_;
+static bool saved_valid_;
+#endif
+
+/********************** internal functions definition ************************/
+static bool valid_(const params_t * p) {
+
+	for(uint8_t i = 0; i < PARAM__N; i++) {
+
+		if(desc_[i].min > p->v[i] || desc_[i].max < p->v[i])
+			return false;
+	}
+	return (p->v[PARAM_BTN_PULSE_MS] < p->v[PARAM_BTN_SHORT_MS] &&
+			p->v[PARAM_BTN_SHORT_MS] < p->v[PARAM_BTN_LONG_MS]);
+}
+
+/* Llamar dentro de una seccion critica: serializa a los escritores. */
+static void publish_(const params_t * p) {
+
+	seq_++;
+	__DMB();
+	for(uint8_t i = 0; i < PARAM__N; i++)
+		cur_[i] = p->v[i];
+	__DMB();
+	seq_++;
+}
+
+static void defaults_(params_t * p) {
+
+	for(uint8_t i = 0; i < PARAM__N; i++)
+		p->v[i] = desc_[i].def;
+}
+
+#if 1 == PARAMS_CONFIG_PERSIST
+static const record_t * slot_(uint8_t bank, uint32_t i) {
+
+	return (const record_t *)(banks_[bank].addr + i * sizeof(record_t));
+}
+
+static uint16_t record_crc_(const record_t * r) {
+
+	return crc16_update(CRC16_INIT, (const uint8_t *)&r->seq, sizeof(r->seq) + sizeof(r->v));
+}
+
+static bool slot_erased_(const record_t * r) {
+
+	const uint32_t * w = (const uint32_t *)r;
+
+	for(uint32_t i = 0; i < RECORD_WORDS_; i++) {
+
+		if(0xFFFFFFFFu != w[i])
+			return false;
+	}
+	return true;
+}
+
+static bool slot_valid_(const record_t * r) {
+
+	return RECORD_MAGIC_ == r->magic && record_crc_(r) == (uint16_t)r->crc;
+}
+
+/* Sigue al ultimo lugar no borrado: los huecos de una escritura fallida quedan atras. */
+static uint32_t next_free_(uint8_t bank) {
+
+	uint32_t next = 0;
+
+	for(uint32_t i = 0; i < SLOTS_; i++) {
+
+		if(!slot_erased_(slot_(bank, i)))
+			next = i + 1;
+	}
+	return next;
+}
+
+/* Recorre todos los lugares de los dos sectores (sin cortar en el primero
+ * borrado) y se queda con el registro valido de mayor secuencia; su sector
+ * pasa a ser el sector en uso. Uno a medio grabar solo ocupa su lugar. */
+static bool load_(params_t * out) {
+
+	const record_t * best = NULL;
+
+	bank_ = 0;
+	for(uint8_t b = 0; b < BANKS_; b++) {
+
+		for(uint32_t i = 0; i < SLOTS_; i++) {
+
+			const record_t * r = slot_(b, i);
+
+			if(slot_valid_(r) && (NULL == best || r->seq > best->seq)) {
+
+				best = r;
+				bank_ = b;
+			}
+		}
+	}
+	slot_next_ = next_free_(bank_);
+
+	if(NULL == best)
+		return false;
+	memcpy(out->v, best->v, sizeof(out->v));
+	saved_seq_ = best->seq;
+	saved_ = *out;
+	saved_valid_ = true;
+	return valid_(out);
+}
+
+static bool erase_(uint8_t bank) {
+
+	FLASH_EraseInitTypeDef erase = {0};
+	uint32_t sector_error = 0;
+
+	erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+	erase.Sector = banks_[bank].sector;
+	erase.NbSectors = 1;
+	erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+	return (HAL_OK == HAL_FLASHEx_Erase(&erase, &sector_error));
+}
+#endif
+
+/********************** external functions definition ************************/
+bool params_init(void) {
+
+	params_t p;
+	bool loaded = false;
+
+#if 1 == PARAMS_CONFIG_PERSIST
+	loaded = load_(&p);
+#endif
+	if(!loaded)
+		defaults_(&p);
+
+	taskENTER_CRITICAL();
+	publish_(&p);
+	taskEXIT_CRITICAL();
+
+	if(loaded) {
+
+		LOGGER_INFO("[PAR] parametros cargados de flash");
+	} else {
+
+		LOGGER_INFO("[PAR] parametros por defecto");
+	}
+	return loaded;
+}
+
+/* Una palabra: la lectura es atomica y no espera. */
+uint32_t param_get(param_id_t id) {
+
+	return (PARAM__N > id) ? cur_[id] : 0;
+}
+
+/* Copia coherente de todos los valores. Solo desde tareas o ISR que respeten
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY (el escritor corre en seccion critica). */
+void params_snapshot(params_t * out) {
+
+	uint32_t s;
+
+	do {
+
+		s = seq_;
+		__DMB();
+		for(uint8_t i = 0; i < PARAM__N; i++)
+			out->v[i] = cur_[i];
+		__DMB();
+	} while((s & 1u) || s != seq_);
+}
+
+bool param_set(param_id_t id, uint32_t value) {
+
+	params_t p;
+	bool ok = false;
+
+	if(PARAM__N <= id)
+		return false;
+
+	taskENTER_CRITICAL();
+	for(uint8_t i = 0; i < PARAM__N; i++)
+		p.v[i] = cur_[i];
+	p.v[id] = value;
+
+	if(valid_(&p)) {
+
+		if(cur_[id] != value)
+			publish_(&p);
+		ok = true;
+	}
+	taskEXIT_CRITICAL();
+	return ok;
+}
+
+void params_defaults(void) {
+
+	params_t p;
+
+	defaults_(&p);
+	taskENTER_CRITICAL();
+	publish_(&p);
+	taskEXIT_CRITICAL();
+}
+
+/* Cambia con cada escritura publicada. */
+uint32_t params_version(void) {
+
+	return seq_ >> 1;
+}
+
+const param_desc_t * param_desc(param_id_t id) {
+
+	return (PARAM__N > id) ? &desc_[id] : NULL;
+}
+
+bool param_find(const char * name, param_id_t * id) {
+
+	for(uint8_t i = 0; i < PARAM__N; i++) {
+
+		if(0 == strcmp(name, desc_[i].name)) {
+
+			*id = (param_id_t)i;
+			return true;
+		}
+	}
+	return false;
+}
+
+#if 1 == PARAMS_CONFIG_PERSIST
+/* Bloquea (y detiene la CPU) mientras programa; si el sector en uso esta lleno
+ * borra el otro y escribe ahi, sin tocar el registro vigente. */
+bool params_save(void) {
+
+	params_t p;
+	record_t rec;
+	const uint32_t * w = (const uint32_t *)&rec;
+	uint8_t bank = bank_;
+	uint32_t slot = slot_next_;
+	uint32_t addr;
+	bool ok = true;
+
+	params_snapshot(&p);
+	memcpy(rec.v, p.v, sizeof(rec.v));
+
+	if(saved_valid_ && 0 == memcmp(saved_.v, rec.v, sizeof(rec.v)))
+		return true;
+
+	rec.magic = RECORD_MAGIC_;
+	rec.seq = saved_seq_ + 1;
+	rec.crc = 0xFFFF0000u | record_crc_(&rec);
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+						   FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+
+	if(SLOTS_ <= slot) {
+
+		LOGGER_INFO("[PAR] sector lleno: pasando al otro");
+		bank = (bank_ + 1) % BANKS_;
+		slot = 0;
+		ok = erase_(bank);
+	}
+
+	addr = banks_[bank].addr + slot * sizeof(record_t);
+	for(uint32_t i = 0; ok && i < RECORD_WORDS_; i++)
+		ok = (HAL_OK == HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + i * sizeof(uint32_t), w[i]));
+	HAL_FLASH_Lock();
+
+	if(ok)
+		ok = (0 == memcmp(slot_(bank, slot), &rec, sizeof(rec)));
+
+	/* Si fallo en el sector nuevo se sigue en el lleno: el proximo guardado
+	 * vuelve a borrar el otro. En el mismo sector, un lugar que quedo a medio
+	 * grabar se saltea y uno que quedo borrado se reusa. */
+	if(ok) {
+
+		bank_ = bank;
+		slot_next_ = slot + 1;
+		memcpy(saved_.v, rec.v, sizeof(rec.v));
+		saved_seq_ = rec.seq;
+		saved_valid_ = true;
+	} else if(bank == bank_ && !slot_erased_(slot_(bank, slot))) {
+
+		slot_next_ = slot + 1;
+	}
+	return ok;
+}
+#endif
+
+/********************** end of file ******************************************/
@@ -9,12 +9,34 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "main.h"
 #include "cmsis_os.h"
+#include "dwt.h"
 
+#include "app.h"
+#include "mem_pool.h"
 #include "priority_queue.h"
+#include "params.h"
 
 /********************** macros and definitions *******************************/
-#define MAX_QUEUE_LENGTH_            (10)
+#define MAX_QUEUE_LENGTH_            (PRIO_QUEUE_MAX_LENGTH)
+
+#if 1 == PRIO_QUEUE_CONFIG_NOTIFY
+/* Las secciones criticas solo cubren el enlace de punteros: malloc/free quedan afuera. */
+#define QUEUE_LOCK_()                (taskENTER_CRITICAL(), pdTRUE)
+#define QUEUE_UNLOCK_()              taskEXIT_CRITICAL()
+#else
+#define QUEUE_LOCK_()                xSemaphoreTake(queue_mutex, portMAX_DELAY)
+#define QUEUE_UNLOCK_()              xSemaphoreGive(queue_mutex)
+#endif
+
+#if 1 == PRIO_QUEUE_CONFIG_MEASURE
+#define MEASURE_START_()             uint32_t cycles_t0_ = cycle_counter_get()
+#define MEASURE_END_(acc)            measure_add_(&(acc), cycle_counter_get() - cycles_t0_)
+#else
+#define MEASURE_START_()
+#define MEASURE_END_(acc)
+#endif
 
 typedef struct node_t {
 
@@ -24,21 +46,58 @@ typedef struct node_t {
 	uint8_t priority;
 }node_t;
 
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+/* Cada insercion toma su nodo antes de desalojar el ultimo: alcanza con un nodo
+ * extra por productor concurrente (task_ui y el reencolado de task_led). */
+#define NODE_POOL_SIZE_              (MAX_QUEUE_LENGTH_ + 2)
+#endif
+
+typedef struct {
+
+	uint32_t n;
+	uint32_t total;
+	uint32_t max;
+} cycles_acc_t;
+
 /********************** internal data definition *****************************/
 static bool queue_initialized = false;
 static uint16_t queue_count;
+static uint32_t queue_evicted;			// pedidos descartados por cola llena
+static uint16_t queue_limit_ = MAX_QUEUE_LENGTH_;	// PARAM_PQ_MAX_LEN, fijado en prio_queue_init()
 static node_t * queue_head;				// elemento de max prioridad de la cola
 static node_t * queue_tail;				// elemento de min prioridad de la cola
 static node_t * queue_high_prio;
 static node_t * queue_medium_prio;
+#if 0 == PRIO_QUEUE_CONFIG_NOTIFY
 static SemaphoreHandle_t queue_sem;
 static SemaphoreHandle_t queue_mutex;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static StaticSemaphore_t queue_sem_ctrl_;
+static StaticSemaphore_t queue_mutex_ctrl_;
+#endif
+#endif
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static node_t node_pool_[NODE_POOL_SIZE_];
+static node_t * node_free_list_;
+#endif
+static TaskHandle_t queue_consumer;		// tarea a notificar en cada insercion
+#if 1 == PRIO_QUEUE_CONFIG_MEASURE
+static cycles_acc_t cycles_insert;
+static cycles_acc_t cycles_extract;
+#endif
 
 /********************** internal functions declaration ***********************/
-static node_t * find_pos_in_queue_(node_t * new_node);
-static void insert_ordered_node_(node_t * new_node);
-static void delete_rear_node(void);
-static void delete_head_node(void);
+static bool insert_(data_queue_t data, prio_queue_priority_t priority, bool front);
+static bool pop_head_(data_queue_t * data, prio_queue_priority_t * priority);
+static node_t * find_pos_in_queue_(node_t * new_node, bool front);
+static void insert_ordered_node_(node_t * new_node, bool front);
+static node_t * delete_rear_node(void);
+static node_t * delete_head_node(void);
+static node_t * node_alloc_(void);
+static void node_free_(node_t * node);
+#if 1 == PRIO_QUEUE_CONFIG_MEASURE
+static void measure_add_(cycles_acc_t * acc, uint32_t cycles);
+#endif
 
 /********************** external functions definition ************************/
 bool prio_queue_init() {
@@ -49,14 +108,43 @@ bool prio_queue_init() {
 	if(1 >= MAX_QUEUE_LENGTH_)
 		return false;
 
+	/* el pool de nodos es de MAX_QUEUE_LENGTH_: el parametro solo puede acortar la cola */
+	queue_limit_ = (uint16_t)param_get(PARAM_PQ_MAX_LEN);
+	if(2 > queue_limit_ || MAX_QUEUE_LENGTH_ < queue_limit_)
+		queue_limit_ = MAX_QUEUE_LENGTH_;
+
+#if 0 == PRIO_QUEUE_CONFIG_NOTIFY
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+    queue_mutex = xSemaphoreCreateMutexStatic(&queue_mutex_ctrl_);
+#else
     queue_mutex = xSemaphoreCreateMutex();
+#endif
 
     if(NULL == queue_mutex)
     	return false;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+    queue_sem = xSemaphoreCreateCountingStatic(MAX_QUEUE_LENGTH_, 0, &queue_sem_ctrl_);
+#else
     queue_sem = xSemaphoreCreateCounting(MAX_QUEUE_LENGTH_, 0);
+#endif
 
 	if(NULL == queue_sem)
 		return false;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("pq_mutex", sizeof(queue_mutex_ctrl_));
+	app_static_report("pq_sem", sizeof(queue_sem_ctrl_));
+#endif
+#endif
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	node_free_list_ = NULL;
+
+	for(uint16_t i = 0; i < NODE_POOL_SIZE_; i++) {
+
+		node_pool_[i].next = node_free_list_;
+		node_free_list_ = &node_pool_[i];
+	}
+	app_static_report("pq_nodos", sizeof(node_pool_));
+#endif
 	queue_head = NULL;
 	queue_tail = NULL;
 	queue_high_prio = NULL;
@@ -68,65 +156,302 @@ bool prio_queue_init() {
 
 bool prio_queue_insert(data_queue_t data, prio_queue_priority_t priority) {
 
-	if(!queue_initialized)
+	return insert_(data, priority, false);
+}
+
+bool prio_queue_insert_front(data_queue_t data, prio_queue_priority_t priority) {
+
+	return insert_(data, priority, true);
+}
+
+#if 1 == PRIO_QUEUE_CONFIG_NOTIFY
+bool prio_queue_extract(data_queue_t * data, prio_queue_priority_t * priority, TickType_t timeout) {
+
+	TimeOut_t time_out;
+
+	if (!queue_initialized || NULL == data || NULL == priority)
 		return false;
+	vTaskSetTimeOutState(&time_out);
 
-	if (xSemaphoreTake(queue_mutex, portMAX_DELAY) == pdTRUE) {
+	// La notificacion solo despierta al consumidor: la lista es la que dice si hay datos.
+	while(true) {
 
-		node_t* nuevo_nodo = (node_t*)pvPortMalloc(sizeof(node_t));
-		if (NULL == nuevo_nodo) {
+		MEASURE_START_();
 
-			xSemaphoreGive(queue_mutex);
-			return false;
+		if(pop_head_(data, priority)) {
+
+			MEASURE_END_(cycles_extract);
+			return true;
 		}
 
-		if (MAX_QUEUE_LENGTH_ <= queue_count)
-			delete_rear_node();
-		memcpy(&nuevo_nodo->data, &data, sizeof(data_queue_t));
-		nuevo_nodo->priority = priority;
-		nuevo_nodo->prev = NULL;
-		nuevo_nodo->next = NULL;
-		insert_ordered_node_(nuevo_nodo);
-		queue_count++;
-		xSemaphoreGive(queue_mutex);
-		xSemaphoreGive(queue_sem);  // notifica que hay un elemento disponible
+		if(pdTRUE == xTaskCheckForTimeOut(&time_out, &timeout))
+			return false;
+		ulTaskNotifyTake(pdTRUE, timeout);
 	}
-	return true;
 }
-
+#else
 bool prio_queue_extract(data_queue_t * data, prio_queue_priority_t * priority, TickType_t timeout) {
 
 	if (!queue_initialized)
 		return false;
 
+	if (NULL == data || NULL == priority)
+		return false;
+
+	// solo se miden las extracciones que encuentran un dato disponible (sin bloqueo)
+	bool ready = (0 < uxSemaphoreGetCount(queue_sem));
+	MEASURE_START_();
+
 	// Espera hasta que haya al menos un dato disponible
 	if(pdTRUE != xSemaphoreTake(queue_sem, timeout))
 		return false;
 
-	if(pdTRUE == xSemaphoreTake(queue_mutex, portMAX_DELAY)) {
+	if(!pop_head_(data, priority))
+		return false;
 
-		if(NULL == queue_head) {
+	if(ready) {
 
-			xSemaphoreGive(queue_mutex);
-			return false;
+		MEASURE_END_(cycles_extract);
+	}
+	return true;
+}
+#endif
+
+bool prio_queue_peek_priority(prio_queue_priority_t * priority) {
+
+	bool ret = false;
+
+	if(!queue_initialized || NULL == priority)
+		return false;
+
+	if(pdTRUE == QUEUE_LOCK_()) {
+
+		if(NULL != queue_head) {
+
+			*priority = queue_head->priority;
+			ret = true;
 		}
+		QUEUE_UNLOCK_();
+	}
+	return ret;
+}
+
+void prio_queue_register_consumer(TaskHandle_t task) {
+
+	queue_consumer = task;
+}
+
+uint16_t prio_queue_count(void) {
+
+	/* lectura de 16 bits: atomica en Cortex-M, no hace falta tomar el mutex. */
+	return queue_count;
+}
+
+uint16_t prio_queue_limit(void) {
+
+	return queue_limit_;
+}
+
+uint32_t prio_queue_evicted(void) {
+
+	return queue_evicted;
+}
+
+/* Escritura de 32 bits: atomica; a lo sumo se pierde un desalojo concurrente. */
+void prio_queue_reset_evicted(void) {
+
+	queue_evicted = 0;
+}
+
+void prio_queue_get_cycles(prio_queue_cycles_t * cycles) {
+
+	memset(cycles, 0, sizeof(*cycles));
+#if 1 == PRIO_QUEUE_CONFIG_MEASURE
+	taskENTER_CRITICAL();
+	cycles->insert_n = cycles_insert.n;
+	cycles->insert_cycles_avg = cycles_insert.n ? (cycles_insert.total / cycles_insert.n) : 0;
+	cycles->insert_cycles_max = cycles_insert.max;
+	cycles->extract_n = cycles_extract.n;
+	cycles->extract_cycles_avg = cycles_extract.n ? (cycles_extract.total / cycles_extract.n) : 0;
+	cycles->extract_cycles_max = cycles_extract.max;
+	taskEXIT_CRITICAL();
+#endif
+}
+
+#if 1 == PRIO_QUEUE_CONFIG_SELFTEST
+/* Recorre la lista y verifica enlaces, orden, cursores de clase y contador.
+ * Sin lock: solo para la autoprueba, que corre con un unico usuario. */
+bool prio_queue_check_integrity(void) {
+
+	node_t * last_high = NULL;
+	node_t * last_medium = NULL;
+	node_t * prev = NULL;
+	uint16_t n = 0;
 
-		if (NULL == data || NULL == priority) {
+	for(node_t * node = queue_head; NULL != node; node = node->next) {
 
-			xSemaphoreGive(queue_mutex);
+		if(node->prev != prev || MAX_QUEUE_LENGTH_ < ++n)
+			return false;
+
+		if(NULL != prev && prev->priority < node->priority)
+			return false;
+
+		if(PRIO_QUEUE_PRIORITY_HIGH == node->priority)
+			last_high = node;
+
+		if(PRIO_QUEUE_PRIORITY_MEDIUM == node->priority)
+			last_medium = node;
+		prev = node;
+	}
+	return prev == queue_tail && n == queue_count && last_high == queue_high_prio &&
+		   last_medium == queue_medium_prio;
+}
+#endif
+
+/********************** internal functions definition ************************/
+static bool insert_(data_queue_t data, prio_queue_priority_t priority, bool front) {
+
+	if(!queue_initialized)
+		return false;
+
+	MEASURE_START_();
+	node_t * evicted = NULL;
+	node_t* nuevo_nodo = node_alloc_();
+
+	if (NULL == nuevo_nodo)
+		return false;
+	memcpy(&nuevo_nodo->data, &data, sizeof(data_queue_t));
+	nuevo_nodo->priority = priority;
+	nuevo_nodo->prev = NULL;
+	nuevo_nodo->next = NULL;
+
+	if (pdTRUE != QUEUE_LOCK_()) {
+
+		node_free_(nuevo_nodo);
+		return false;
+	}
+
+	if (queue_limit_ <= queue_count) {
+
+		/* lo que vuelve al frente (resto desalojado, reencolado) solo desplaza al
+		 * ultimo si lo supera en prioridad; si no, se descarta el que vuelve */
+		if (front && nuevo_nodo->priority <= queue_tail->priority) {
+
+			queue_evicted++;
+			QUEUE_UNLOCK_();
+			node_free_(nuevo_nodo);
 			return false;
 		}
+		evicted = delete_rear_node();
+		queue_evicted++;
+	}
+	insert_ordered_node_(nuevo_nodo, front);
+	queue_count++;
+	QUEUE_UNLOCK_();
+
+	if(NULL != evicted)
+		node_free_(evicted);
+#if 0 == PRIO_QUEUE_CONFIG_NOTIFY
+	xSemaphoreGive(queue_sem);  // notifica que hay un elemento disponible
+#endif
+
+	// aviso para que el consumidor pueda desalojar; no hace falta cuando es el
+	// mismo consumidor el que devuelve un pedido al frente de la cola.
+	if(NULL != queue_consumer && !front)
+		xTaskNotifyGive(queue_consumer);
+	MEASURE_END_(cycles_insert);
+	return true;
+}
+
+/* Saca el elemento de mayor prioridad; el nodo se libera fuera del lock. */
+static bool pop_head_(data_queue_t * data, prio_queue_priority_t * priority) {
+
+	node_t * node = NULL;
+
+	if(pdTRUE != QUEUE_LOCK_())
+		return false;
+
+	if(NULL != queue_head) {
+
 		*data = queue_head->data;
 		*priority = queue_head->priority;
-		delete_head_node();
-		xSemaphoreGive(queue_mutex);
-		return true;
+		node = delete_head_node();
 	}
-	return false;
+	QUEUE_UNLOCK_();
+
+	if(NULL == node)
+		return false;
+	node_free_(node);
+	return true;
 }
 
-/********************** internal functions definition ************************/
-static node_t * find_pos_in_queue_(node_t * new_node) {
+static node_t * node_alloc_(void) {
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	node_t * node;
+
+	taskENTER_CRITICAL();
+	node = node_free_list_;
+
+	if(NULL != node)
+		node_free_list_ = node->next;
+	taskEXIT_CRITICAL();
+	return node;
+#elif 1 == MEM_POOL_CONFIG_ENABLE
+	return (node_t*)mem_pool_alloc(sizeof(node_t));
+#else
+	return (node_t*)pvPortMalloc(sizeof(node_t));
+#endif
+}
+
+static void node_free_(node_t * node) {
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	taskENTER_CRITICAL();
+	node->next = node_free_list_;
+	node_free_list_ = node;
+	taskEXIT_CRITICAL();
+#elif 1 == MEM_POOL_CONFIG_ENABLE
+	mem_pool_free(node);
+#else
+	vPortFree(node);
+#endif
+}
+
+#if 1 == PRIO_QUEUE_CONFIG_MEASURE
+static void measure_add_(cycles_acc_t * acc, uint32_t cycles) {
+
+	taskENTER_CRITICAL();
+	acc->n++;
+	acc->total += cycles;
+
+	if(cycles > acc->max)
+		acc->max = cycles;
+	taskEXIT_CRITICAL();
+}
+#endif
+
+static node_t * find_pos_in_queue_(node_t * new_node, bool front) {
+
+	if(front) {
+		/* Insertar al frente de su clase: los cursores de "ultimo de la clase"
+		 * solo cambian si la clase estaba vacia. */
+		if(PRIO_QUEUE_PRIORITY_HIGH == new_node->priority) {
+
+			if(NULL == queue_high_prio)
+				queue_high_prio = new_node;
+			return queue_head;
+		}
+		node_t * first_non_high = queue_high_prio ? queue_high_prio->next : queue_head;
+
+		if(PRIO_QUEUE_PRIORITY_MEDIUM == new_node->priority) {
+
+			if(NULL == queue_medium_prio)
+				queue_medium_prio = new_node;
+			return first_non_high;
+		}
+		return queue_medium_prio ? queue_medium_prio->next : first_non_high;
+	}
 
     if(PRIO_QUEUE_PRIORITY_HIGH == new_node->priority) {
         // Insertar ANTES del primer no-HIGH
@@ -147,7 +472,7 @@ static node_t * find_pos_in_queue_(node_t * new_node) {
     return NULL;
 }
 
-static void insert_ordered_node_(node_t * nuevo_nodo) {
+static void insert_ordered_node_(node_t * nuevo_nodo, bool front) {
 
     if(0 == queue_count) {
 
@@ -161,7 +486,7 @@ static void insert_ordered_node_(node_t * nuevo_nodo) {
 			queue_medium_prio = nuevo_nodo;
 		return;
     }
-	node_t* nodo_siguiente = find_pos_in_queue_(nuevo_nodo);
+	node_t* nodo_siguiente = find_pos_in_queue_(nuevo_nodo, front);
 
 	if(NULL == nodo_siguiente) {
 
@@ -186,7 +511,9 @@ static void insert_ordered_node_(node_t * nuevo_nodo) {
 	return;
 }
 
-static void delete_rear_node(void) {
+static node_t * delete_rear_node(void) {
+
+	node_t * node = queue_tail;
 
 	if(queue_tail == queue_high_prio) {
 
@@ -202,12 +529,14 @@ static void delete_rear_node(void) {
 			queue_medium_prio = NULL;
 	}
 	queue_tail = queue_tail->prev;
-	vPortFree(queue_tail->next);
 	queue_tail->next = NULL;
 	queue_count--;
+	return node;
 }
 
-static void delete_head_node(void) {
+static node_t * delete_head_node(void) {
+
+	node_t * node = queue_head;
 
 	if(queue_head == queue_high_prio) {
 
@@ -225,7 +554,6 @@ static void delete_head_node(void) {
 
 	if(queue_head == queue_tail) {
 
-		vPortFree(queue_head);
 		queue_head = NULL;
 		queue_tail = NULL;
 		queue_high_prio = NULL;
@@ -234,8 +562,8 @@ static void delete_head_node(void) {
 	} else {
 
 		queue_head = queue_head->next;
-		vPortFree(queue_head->prev);
 		queue_head->prev = NULL;
 		queue_count--;
 	}
+	return node;
 }
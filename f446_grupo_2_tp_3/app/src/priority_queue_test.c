@@ -0,0 +1,210 @@
+/*
+ * priority_queue_test.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+
+#include "priority_queue.h"
+#include "priority_queue_test.h"
+
+#if 1 == PRIO_QUEUE_CONFIG_SELFTEST
+
+/********************** macros and definitions *******************************/
+/* op: bits 0-1 tipo, bits 2-3 prioridad. Tres de cada cuatro operaciones
+ * insertan, asi la cola se llena y se ejercita el desalojo. */
+#define OP_INSERT_                  (0)
+#define OP_INSERT_FRONT_            (1)
+#define OP_EXTRACT_                 (2)
+#define OP_KIND_(op)                (((op) & 0x3) == 0x3 ? OP_INSERT_ : ((op) & 0x3))
+#define OP_PRIO_(op)                ((prio_queue_priority_t)((((op) >> 2) & 0x3) % 3))
+
+typedef struct {
+
+	prio_queue_priority_t prio;
+	uint32_t id;
+} model_entry_t;
+
+/********************** internal data definition *****************************/
+static uint32_t rng_;
+static uint32_t next_id_;
+static model_entry_t model_[PRIO_QUEUE_MAX_LENGTH];
+static uint16_t model_n_;
+static uint8_t seq_[PRIO_QUEUE_TEST_SEQ_LEN];
+static uint8_t try_[PRIO_QUEUE_TEST_SEQ_LEN];
+
+static const char * const op_name_[] = {"insert", "front", "extract"};
+static const char * const prio_name_[] = {"LOW", "MEDIUM", "HIGH"};
+
+/********************** internal functions definition ************************/
+static uint32_t rand_(void) {
+
+	rng_ ^= rng_ << 13;
+	rng_ ^= rng_ >> 17;
+	rng_ ^= rng_ << 5;
+	return rng_;
+}
+
+/* Devuelve false si la cola tiene que rechazar el pedido. */
+static bool model_insert_(prio_queue_priority_t prio, uint32_t id, bool front) {
+
+	uint16_t pos = 0;
+
+	if(prio_queue_limit() <= model_n_) {
+
+		if(front && prio <= model_[model_n_ - 1].prio)
+			return false;		/* al frente solo desaloja a uno de menor prioridad */
+		model_n_--;				/* desalojo: el ultimo de la cola */
+	}
+
+	/* al fondo de su clase, o al frente con insert_front */
+	while(pos < model_n_ && (front ? model_[pos].prio > prio : model_[pos].prio >= prio))
+		pos++;
+	memmove(&model_[pos + 1], &model_[pos], (model_n_ - pos) * sizeof(model_[0]));
+	model_[pos].prio = prio;
+	model_[pos].id = id;
+	model_n_++;
+	return true;
+}
+
+static void reset_(void) {
+
+	data_queue_t data;
+	prio_queue_priority_t prio;
+
+	while(prio_queue_extract(&data, &prio, 0));
+	model_n_ = 0;
+}
+
+static bool apply_(uint8_t op) {
+
+	data_queue_t data = {AO_LED_MESSAGE_ON, AO_LED_COLOR_RED, 0};
+	prio_queue_priority_t prio = OP_PRIO_(op);
+	bool ok;
+
+	switch(OP_KIND_(op)) {
+
+		case OP_INSERT_:
+		case OP_INSERT_FRONT_:
+			data.hold_ms = ++next_id_;
+
+			if(OP_INSERT_ == OP_KIND_(op))
+				ok = prio_queue_insert(data, prio);
+			else
+				ok = prio_queue_insert_front(data, prio);
+
+			if(ok != model_insert_(prio, next_id_, OP_INSERT_FRONT_ == OP_KIND_(op)))
+				return false;
+			break;
+		default:
+			ok = prio_queue_extract(&data, &prio, 0);
+
+			if(0 == model_n_) {
+
+				if(ok)
+					return false;
+				break;
+			}
+
+			if(!ok || prio != model_[0].prio || data.hold_ms != model_[0].id)
+				return false;
+			model_n_--;
+			memmove(&model_[0], &model_[1], model_n_ * sizeof(model_[0]));
+			break;
+	}
+	return prio_queue_check_integrity() && model_n_ == prio_queue_count();
+}
+
+/* Corre ops[] desde la cola vacia; false en la primera discrepancia. */
+static bool run_(const uint8_t * ops, uint8_t n) {
+
+	reset_();
+
+	for(uint8_t i = 0; i < n; i++) {
+
+		if(!apply_(ops[i]))
+			return false;
+	}
+	return true;
+}
+
+/* Reduccion voraz: quita una operacion a la vez mientras la secuencia siga fallando. */
+static uint8_t shrink_(uint8_t * ops, uint8_t n) {
+
+	bool changed = true;
+
+	while(changed) {
+
+		changed = false;
+
+		for(uint8_t i = 0; i < n; i++) {
+
+			memcpy(try_, ops, i);
+			memcpy(&try_[i], &ops[i + 1], n - i - 1);
+
+			if(!run_(try_, n - 1)) {
+
+				memcpy(ops, try_, n - 1);
+				n--;
+				changed = true;
+				break;
+			}
+		}
+	}
+	return n;
+}
+
+/********************** external functions definition ************************/
+bool prio_queue_selftest(uint32_t seed, uint32_t episodes) {
+
+	uint64_t cycles = 0;
+	uint32_t ops = 0;
+	uint32_t t0;
+
+	rng_ = (0 == seed) ? 1 : seed;
+	next_id_ = 0;
+	cycle_counter_init();
+
+	for(uint32_t episode = 0; episode < episodes; episode++) {
+
+		for(uint8_t i = 0; i < PRIO_QUEUE_TEST_SEQ_LEN; i++)
+			seq_[i] = (uint8_t)rand_();
+
+		t0 = cycle_counter_get();
+		bool ok = run_(seq_, PRIO_QUEUE_TEST_SEQ_LEN);
+		cycles += cycle_counter_get() - t0;
+		ops += PRIO_QUEUE_TEST_SEQ_LEN;
+
+		if(!ok) {
+
+			uint8_t n = shrink_(seq_, PRIO_QUEUE_TEST_SEQ_LEN);
+
+			LOGGER_INFO("[PQT] falla episodio %lu, semilla %lx", (unsigned long)episode, (unsigned long)seed);
+			for(uint8_t i = 0; i < n; i++) {
+
+				LOGGER_INFO("[PQT] %u: %s %s", i, op_name_[OP_KIND_(seq_[i])], prio_name_[OP_PRIO_(seq_[i])]);
+			}
+			reset_();
+			return false;
+		}
+	}
+	reset_();
+
+	LOGGER_INFO("[PQT] ok: %lu ops, %lu ops/s", (unsigned long)ops,
+				(unsigned long)((0 == cycles) ? 0 : ((uint64_t)ops * SystemCoreClock) / cycles));
+	return true;
+}
+
+#endif
+
+/********************** end of file ******************************************/
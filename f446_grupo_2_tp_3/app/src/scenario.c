@@ -0,0 +1,191 @@
+/*
+ * scenario.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+
+#include "scenario.h"
+
+/********************** macros and definitions *******************************/
+
+/********************** internal data definition *****************************/
+static struct {
+
+	uint16_t idx;				/* escenario en curso */
+	uint8_t input_idx;			/* proxima entrada a inyectar */
+	bool started;
+	TickType_t t0;				/* inicio del escenario, en ticks (tiempo simulado) */
+	uint32_t real_t0_ms;		/* inicio del escenario, base de la HAL */
+	uint16_t passed;
+	uint16_t failed;
+	uint16_t captured;
+} run_;
+
+static scenario_led_t trace_[SCENARIO_CONFIG_TRACE_LEN];
+static volatile uint8_t trace_n_;
+static uint32_t trace_lost_;
+
+static const char * const color_name_[AO_LED_COLOR__N] = {
+
+	[AO_LED_COLOR_RED]   = "AO_LED_COLOR_RED",
+	[AO_LED_COLOR_GREEN] = "AO_LED_COLOR_GREEN",
+	[AO_LED_COLOR_BLUE]  = "AO_LED_COLOR_BLUE",
+};
+
+/********************** internal functions definition ************************/
+static uint32_t elapsed_ms_(void) {
+
+	return (uint32_t)(xTaskGetTickCount() - run_.t0) * portTICK_PERIOD_MS;
+}
+
+static void start_(uint16_t idx) {
+
+	run_.idx = idx;
+	run_.input_idx = 0;
+
+	/* task_led puede estar agregando un flanco (scenario_on_led) */
+	taskENTER_CRITICAL();
+	trace_n_ = 0;
+	trace_lost_ = 0;
+	run_.real_t0_ms = HAL_GetTick();
+	run_.t0 = xTaskGetTickCount();
+	taskEXIT_CRITICAL();
+	LOGGER_INFO("[SCN] %u/%u %s", idx + 1, scenario_table_n, scenario_table[idx].name);
+}
+
+/* Formato de las lineas: se pegan tal cual como golden en scenario_table.c. */
+static void dump_(void) {
+
+	for(uint8_t i = 0; i < trace_n_; i++) {
+
+		LOGGER_INFO("{%lu, %s, %s},", (unsigned long)trace_[i].at_ms, color_name_[trace_[i].color],
+					trace_[i].on ? "true" : "false");
+	}
+}
+
+static bool check_(const scenario_t * s) {
+
+	if(0 != trace_lost_ || trace_n_ != s->golden_n) {
+
+		LOGGER_INFO("[SCN] %u flancos (%lu perdidos), esperados %u", trace_n_, (unsigned long)trace_lost_,
+					s->golden_n);
+		return false;
+	}
+
+	for(uint8_t i = 0; i < trace_n_; i++) {
+
+		const scenario_led_t * g = &s->golden[i];
+		const scenario_led_t * t = &trace_[i];
+		uint32_t diff = (t->at_ms > g->at_ms) ? t->at_ms - g->at_ms : g->at_ms - t->at_ms;
+
+		if(g->color != t->color || g->on != t->on ||
+		   (SCENARIO_ANY_MS != g->at_ms && SCENARIO_CONFIG_TOLERANCE_MS < diff)) {
+
+			LOGGER_INFO("[SCN] flanco %u: led %u %u @%lu ms", i, t->color, t->on, (unsigned long)t->at_ms);
+			LOGGER_INFO("[SCN] esperado: led %u %u @%lu ms", g->color, g->on, (unsigned long)g->at_ms);
+			return false;
+		}
+	}
+	return true;
+}
+
+static void finish_(const scenario_t * s) {
+
+	uint32_t sim_ms = elapsed_ms_();
+	uint32_t real_ms = HAL_GetTick() - run_.real_t0_ms;
+
+	if(NULL == s->golden) {
+
+		run_.captured++;
+		LOGGER_INFO("[SCN] %s: sin golden, traza:", s->name);
+		dump_();
+	} else if(check_(s)) {
+
+		run_.passed++;
+		LOGGER_INFO("[SCN] %s ok", s->name);
+	} else {
+
+		run_.failed++;
+		LOGGER_INFO("[SCN] %s FALLA", s->name);
+	}
+	LOGGER_INFO("[SCN] %lu ms sim, %lu ms real", (unsigned long)sim_ms, (unsigned long)real_ms);
+}
+
+/********************** external functions definition ************************/
+/* Llamado por get_button_type() en cada muestreo del boton: entrega a lo sumo
+ * una entrada por periodo, como un boton real. */
+button_type_t scenario_poll(void) {
+
+	const scenario_t * s;
+	uint32_t now;
+	uint32_t last;
+
+	if(scenario_table_n <= run_.idx)
+		return BUTTON_TYPE_NONE;
+
+	if(!run_.started) {
+
+		run_.started = true;
+		start_(0);
+	}
+
+	s = &scenario_table[run_.idx];
+	now = elapsed_ms_();
+
+	if(run_.input_idx < s->inputs_n) {
+
+		if(s->inputs[run_.input_idx].at_ms <= now)
+			return s->inputs[run_.input_idx++].button;
+		return BUTTON_TYPE_NONE;
+	}
+
+	last = (0 == s->inputs_n) ? 0 : s->inputs[s->inputs_n - 1].at_ms;
+	if(now < last + s->settle_ms)
+		return BUTTON_TYPE_NONE;
+
+	finish_(s);
+	if(++run_.idx < scenario_table_n) {
+
+		start_(run_.idx);
+	} else {
+
+		LOGGER_INFO("[SCN] fin: %u ok, %u fallas, %u sin golden", run_.passed, run_.failed, run_.captured);
+	}
+	return BUTTON_TYPE_NONE;
+}
+
+/* Llamado por AO LED en cada flanco de un LED. Corre en task_led, en paralelo
+ * con start_() en task_button: el agregado va en seccion critica. */
+void scenario_on_led(ao_led_color_t color, bool on) {
+
+	uint8_t n;
+
+	if(!run_.started || scenario_table_n <= run_.idx)
+		return;
+
+	taskENTER_CRITICAL();
+	n = trace_n_;
+
+	if(SCENARIO_CONFIG_TRACE_LEN <= n) {
+
+		trace_lost_++;
+	} else {
+
+		trace_[n].at_ms = elapsed_ms_();
+		trace_[n].color = color;
+		trace_[n].on = on;
+		trace_n_ = n + 1;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,228 @@
+/*
+ * scenario_table.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+
+#include "scenario.h"
+
+/********************** macros and definitions *******************************/
+#define N_(array)       (sizeof(array) / sizeof((array)[0]))
+
+/* Tiempos en ms desde el inicio de cada escenario. El boton se muestrea cada
+ * 50 ms: una entrada a los 50 ms equivale a la antigua secuencia NONE, X.
+ * Las salidas de referencia dependen de la configuracion de AO LED: con
+ * AO_LED_CONFIG_PARALLEL en 0 un solo LED a la vez (comportamiento original),
+ * con 1 un carril por color. */
+
+/********************** internal data definition *****************************/
+/* 1: un pulso con el sistema en reposo (ex TESTING_ARRAY_INPUTS_1). */
+static const scenario_input_t pulse_in_[] = {
+
+	{50, BUTTON_TYPE_PULSE},
+};
+
+static const scenario_led_t pulse_golden_[] = {
+
+	{50,   AO_LED_COLOR_RED, true},
+	{5050, AO_LED_COLOR_RED, false},
+};
+
+/* 2: un evento de cada tipo (ex TESTING_ARRAY_INPUTS_2). */
+static const scenario_input_t each_in_[] = {
+
+	{50,  BUTTON_TYPE_PULSE},
+	{150, BUTTON_TYPE_SHORT},
+	{250, BUTTON_TYPE_LONG},
+};
+
+#if 0 == AO_LED_CONFIG_PARALLEL && 0 == AO_LED_CONFIG_ADAPTIVE_HOLD
+/* de a uno y por prioridad: ALTA, MEDIA, BAJA */
+static const scenario_led_t each_golden_[] = {
+
+	{50,    AO_LED_COLOR_RED,   true},
+	{5050,  AO_LED_COLOR_RED,   false},
+	{5050,  AO_LED_COLOR_GREEN, true},
+	{10050, AO_LED_COLOR_GREEN, false},
+	{10050, AO_LED_COLOR_BLUE,  true},
+	{15050, AO_LED_COLOR_BLUE,  false},
+};
+#define EACH_GOLDEN_            each_golden_
+#elif 1 == AO_LED_CONFIG_PARALLEL
+/* cada color tiene su carril; la cola nunca tiene pendientes */
+static const scenario_led_t each_golden_[] = {
+
+	{50,   AO_LED_COLOR_RED,   true},
+	{150,  AO_LED_COLOR_GREEN, true},
+	{250,  AO_LED_COLOR_BLUE,  true},
+	{5050, AO_LED_COLOR_RED,   false},
+	{5150, AO_LED_COLOR_GREEN, false},
+	{5250, AO_LED_COLOR_BLUE,  false},
+};
+#define EACH_GOLDEN_            each_golden_
+#endif
+
+/* 3: rafaga de 11 eventos, primero los de baja prioridad (ex TESTING_ARRAY_INPUTS_3):
+ * 2 de BAJA, 5 de MEDIA y 4 de ALTA. Todos pasan el limitador de AO UI y la cola
+ * de prioridad llega justo a su capacidad (10) sin desalojar. El orden de
+ * atencion depende del desalojo, los carriles y el tiempo adaptativo de AO LED. */
+static const scenario_input_t burst_in_[] = {
+
+	{50,   BUTTON_TYPE_LONG},
+	{150,  BUTTON_TYPE_LONG},
+	{250,  BUTTON_TYPE_SHORT},
+	{350,  BUTTON_TYPE_SHORT},
+	{450,  BUTTON_TYPE_PULSE},
+	{550,  BUTTON_TYPE_SHORT},
+	{650,  BUTTON_TYPE_SHORT},
+	{750,  BUTTON_TYPE_SHORT},
+	{850,  BUTTON_TYPE_PULSE},
+	{950,  BUTTON_TYPE_PULSE},
+	{1050, BUTTON_TYPE_PULSE},
+};
+
+#if 0 == AO_LED_CONFIG_PARALLEL && 0 == AO_LED_CONFIG_ADAPTIVE_HOLD && 0 == AO_LED_CONFIG_PREEMPT
+/* de a uno, 5 s cada uno: el primero BAJA y despues ALTA, MEDIA y BAJA en orden de llegada */
+static const scenario_led_t burst_golden_[] = {
+
+	{50,    AO_LED_COLOR_BLUE,  true},
+	{5050,  AO_LED_COLOR_BLUE,  false},
+	{5050,  AO_LED_COLOR_RED,   true},
+	{10050, AO_LED_COLOR_RED,   false},
+	{10050, AO_LED_COLOR_RED,   true},
+	{15050, AO_LED_COLOR_RED,   false},
+	{15050, AO_LED_COLOR_RED,   true},
+	{20050, AO_LED_COLOR_RED,   false},
+	{20050, AO_LED_COLOR_RED,   true},
+	{25050, AO_LED_COLOR_RED,   false},
+	{25050, AO_LED_COLOR_GREEN, true},
+	{30050, AO_LED_COLOR_GREEN, false},
+	{30050, AO_LED_COLOR_GREEN, true},
+	{35050, AO_LED_COLOR_GREEN, false},
+	{35050, AO_LED_COLOR_GREEN, true},
+	{40050, AO_LED_COLOR_GREEN, false},
+	{40050, AO_LED_COLOR_GREEN, true},
+	{45050, AO_LED_COLOR_GREEN, false},
+	{45050, AO_LED_COLOR_GREEN, true},
+	{50050, AO_LED_COLOR_GREEN, false},
+	{50050, AO_LED_COLOR_BLUE,  true},
+	{55050, AO_LED_COLOR_BLUE,  false},
+};
+#define BURST_GOLDEN_           burst_golden_
+#elif 0 == AO_LED_CONFIG_PARALLEL && 0 == AO_LED_CONFIG_ADAPTIVE_HOLD
+/* con desalojo: el verde corta al azul y el rojo al verde; lo que resta (4800 ms)
+ * vuelve al frente de su prioridad */
+static const scenario_led_t burst_golden_[] = {
+
+	{50,    AO_LED_COLOR_BLUE,  true},
+	{250,   AO_LED_COLOR_BLUE,  false},
+	{250,   AO_LED_COLOR_GREEN, true},
+	{450,   AO_LED_COLOR_GREEN, false},
+	{450,   AO_LED_COLOR_RED,   true},
+	{5450,  AO_LED_COLOR_RED,   false},
+	{5450,  AO_LED_COLOR_RED,   true},
+	{10450, AO_LED_COLOR_RED,   false},
+	{10450, AO_LED_COLOR_RED,   true},
+	{15450, AO_LED_COLOR_RED,   false},
+	{15450, AO_LED_COLOR_RED,   true},
+	{20450, AO_LED_COLOR_RED,   false},
+	{20450, AO_LED_COLOR_GREEN, true},
+	{25250, AO_LED_COLOR_GREEN, false},
+	{25250, AO_LED_COLOR_GREEN, true},
+	{30250, AO_LED_COLOR_GREEN, false},
+	{30250, AO_LED_COLOR_GREEN, true},
+	{35250, AO_LED_COLOR_GREEN, false},
+	{35250, AO_LED_COLOR_GREEN, true},
+	{40250, AO_LED_COLOR_GREEN, false},
+	{40250, AO_LED_COLOR_GREEN, true},
+	{45250, AO_LED_COLOR_GREEN, false},
+	{45250, AO_LED_COLOR_BLUE,  true},
+	{50050, AO_LED_COLOR_BLUE,  false},
+	{50050, AO_LED_COLOR_BLUE,  true},
+	{55050, AO_LED_COLOR_BLUE,  false},
+};
+#define BURST_GOLDEN_           burst_golden_
+#elif 1 == AO_LED_CONFIG_PARALLEL && 0 == AO_LED_CONFIG_ADAPTIVE_HOLD
+/* carriles, 5 s cada uno: con el carril rojo ocupado y su lugar de espera tomado,
+ * el rojo pendiente frena el despacho y el verde espera aunque su carril este libre */
+static const scenario_led_t burst_golden_[] = {
+
+	{50,    AO_LED_COLOR_BLUE,  true},
+	{250,   AO_LED_COLOR_GREEN, true},
+	{450,   AO_LED_COLOR_RED,   true},
+	{5050,  AO_LED_COLOR_BLUE,  false},
+	{5050,  AO_LED_COLOR_BLUE,  true},
+	{5250,  AO_LED_COLOR_GREEN, false},
+	{5250,  AO_LED_COLOR_GREEN, true},
+	{5450,  AO_LED_COLOR_RED,   false},
+	{5450,  AO_LED_COLOR_RED,   true},
+	{10050, AO_LED_COLOR_BLUE,  false},
+	{10250, AO_LED_COLOR_GREEN, false},
+	{10450, AO_LED_COLOR_RED,   false},
+	{10450, AO_LED_COLOR_RED,   true},
+	{10450, AO_LED_COLOR_GREEN, true},
+	{15450, AO_LED_COLOR_RED,   false},
+	{15450, AO_LED_COLOR_RED,   true},
+	{15450, AO_LED_COLOR_GREEN, false},
+	{15450, AO_LED_COLOR_GREEN, true},
+	{20450, AO_LED_COLOR_RED,   false},
+	{20450, AO_LED_COLOR_GREEN, false},
+	{20450, AO_LED_COLOR_GREEN, true},
+	{25450, AO_LED_COLOR_GREEN, false},
+};
+#define BURST_GOLDEN_           burst_golden_
+#else
+/* carriles con tiempo adaptativo: el recorte depende de lo pendiente al encender
+ * (5 pendientes: azul 3000, verde 3500, rojo 4000 ms) */
+static const scenario_led_t burst_golden_[] = {
+
+	{50,    AO_LED_COLOR_BLUE,  true},
+	{250,   AO_LED_COLOR_GREEN, true},
+	{450,   AO_LED_COLOR_RED,   true},
+	{5050,  AO_LED_COLOR_BLUE,  false},
+	{5050,  AO_LED_COLOR_BLUE,  true},
+	{5250,  AO_LED_COLOR_GREEN, false},
+	{5250,  AO_LED_COLOR_GREEN, true},
+	{5450,  AO_LED_COLOR_RED,   false},
+	{5450,  AO_LED_COLOR_RED,   true},
+	{8050,  AO_LED_COLOR_BLUE,  false},
+	{8750,  AO_LED_COLOR_GREEN, false},
+	{9450,  AO_LED_COLOR_RED,   false},
+	{9450,  AO_LED_COLOR_RED,   true},
+	{9450,  AO_LED_COLOR_GREEN, true},
+	{13650, AO_LED_COLOR_RED,   false},
+	{13650, AO_LED_COLOR_RED,   true},
+	{13850, AO_LED_COLOR_GREEN, false},
+	{13850, AO_LED_COLOR_GREEN, true},
+	{18450, AO_LED_COLOR_RED,   false},
+	{18550, AO_LED_COLOR_GREEN, false},
+	{18550, AO_LED_COLOR_GREEN, true},
+	{23550, AO_LED_COLOR_GREEN, false},
+};
+#define BURST_GOLDEN_           burst_golden_
+#endif
+
+/********************** external data definition *****************************/
+const scenario_t scenario_table[] = {
+
+	{"pulso",  pulse_in_, N_(pulse_in_), pulse_golden_, N_(pulse_golden_), 6000},
+#ifdef EACH_GOLDEN_
+	{"tipos",  each_in_,  N_(each_in_),  EACH_GOLDEN_,  N_(EACH_GOLDEN_),  16000},
+#endif
+#ifdef BURST_GOLDEN_
+	{"rafaga", burst_in_, N_(burst_in_), BURST_GOLDEN_, N_(BURST_GOLDEN_), 56000},
+#endif
+};
+
+const uint16_t scenario_table_n = N_(scenario_table);
+
+/********************** end of file ******************************************/
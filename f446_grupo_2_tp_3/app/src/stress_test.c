@@ -0,0 +1,296 @@
+/*
+ * stress_test.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+
+#include "app.h"
+#include "priority_queue.h"
+#include "work_queue.h"
+#include "task_monitor.h"
+#include "stress_test.h"
+
+#if 1 == STRESS_TEST_CONFIG_ENABLE
+
+/********************** macros and definitions *******************************/
+#define P_                      (STRESS_TEST_PRODUCERS)
+#define TASK_IDS_               (P_ * STRESS_TEST_ITEMS)
+#define IDS_                    (TASK_IDS_ + STRESS_TEST_ISR_ITEMS)
+#define BITMAP_WORDS_           ((IDS_ + 31) / 32)
+#define DRAIN_TIMEOUT_MS_       (1000)
+
+typedef struct {
+
+	uint32_t inserted;
+	uint32_t rejected;			/* prio_queue_insert sin nodo libre */
+	uint32_t submitted;
+	uint32_t retries;			/* work_submit con la cola llena */
+} producer_stats_t;
+
+/********************** internal data definition *****************************/
+static TaskHandle_t h_ctrl_;
+static TaskHandle_t h_producer_[P_];
+static producer_stats_t producer_[P_];
+
+/* escritos solo por el consumidor de la cola de prioridad */
+static uint32_t prio_seen_[BITMAP_WORDS_];
+static uint32_t next_seq_[P_][PRIO_QUEUE_PRIORITY_HIGH + 1];
+static uint32_t received_;
+static uint32_t prio_dups_;
+static uint32_t order_errors_;
+
+/* escritos por los trabajadores, en seccion critica */
+static uint32_t work_seen_[BITMAP_WORDS_];
+static uint32_t executed_;
+static uint32_t work_dups_;
+
+static volatile bool isr_active_;
+static uint32_t isr_submitted_;
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static StaticTask_t ctrl_tcb_;
+static StackType_t ctrl_stack_[STRESS_TEST_CTRL_STACK_SIZE];
+static StaticTask_t consumer_tcb_;
+static StackType_t consumer_stack_[STRESS_TEST_STACK_SIZE];
+static StaticTask_t producer_tcb_[P_];
+static StackType_t producer_stack_[P_][STRESS_TEST_STACK_SIZE];
+#endif
+
+/********************** internal functions definition ************************/
+static bool test_and_set_(uint32_t * bitmap, uint32_t id) {
+
+	uint32_t mask = 1u << (id % 32);
+	bool was = (0 != (bitmap[id / 32] & mask));
+
+	bitmap[id / 32] |= mask;
+	return was;
+}
+
+static void job_(void * arg) {
+
+	uint32_t id = (uint32_t)(uintptr_t)arg;
+
+	taskENTER_CRITICAL();
+	executed_++;
+
+	if(IDS_ <= id || test_and_set_(work_seen_, id))
+		work_dups_++;
+	taskEXIT_CRITICAL();
+}
+
+static void task_producer_(void * argument) {
+
+	uint8_t p = (uint8_t)(uintptr_t)argument;
+	producer_stats_t * st = &producer_[p];
+
+	while(true) {
+
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		for(uint32_t s = 0; s < STRESS_TEST_ITEMS; s++) {
+
+			uint32_t id = p * STRESS_TEST_ITEMS + s;
+			data_queue_t data = {AO_LED_MESSAGE_ON, AO_LED_COLOR_RED, id};
+
+			if(prio_queue_insert(data, (prio_queue_priority_t)(s % 3)))
+				st->inserted++;
+			else
+				st->rejected++;
+
+			while(!work_submit(job_, (void *)(uintptr_t)id, WORK_PRIO_NORMAL)) {
+
+				st->retries++;
+				taskYIELD();
+			}
+			st->submitted++;
+		}
+		xTaskNotifyGive(h_ctrl_);
+	}
+}
+
+/* Mismo productor y prioridad: FIFO. El desalojo solo puede dejar huecos. */
+static void task_consumer_(void * argument) {
+
+	data_queue_t data;
+	prio_queue_priority_t prio;
+
+	while(true) {
+
+		if(!prio_queue_extract(&data, &prio, portMAX_DELAY))
+			continue;
+
+		uint32_t id = data.hold_ms;
+
+		received_++;
+
+		if(TASK_IDS_ <= id || test_and_set_(prio_seen_, id)) {
+
+			prio_dups_++;
+			continue;
+		}
+		uint32_t p = id / STRESS_TEST_ITEMS;
+		uint32_t seq = id % STRESS_TEST_ITEMS;
+
+		if(prio != (prio_queue_priority_t)(seq % 3) || seq < next_seq_[p][prio])
+			order_errors_++;
+		next_seq_[p][prio] = seq + 1;
+	}
+}
+
+/* Ronda con n productores; todas las tareas de la prueba quedan bloqueadas
+ * entre rondas, asi que el estado se puede reiniciar sin lock. */
+static bool round_(uint8_t n) {
+
+	producer_stats_t sum = {0};
+	uint32_t evicted0 = prio_queue_evicted();
+	uint32_t evicted;
+	uint32_t cycles;
+	uint32_t ops;
+	TickType_t start;
+
+	memset(producer_, 0, sizeof(producer_));
+	memset(prio_seen_, 0, sizeof(prio_seen_));
+	memset(work_seen_, 0, sizeof(work_seen_));
+	memset(next_seq_, 0, sizeof(next_seq_));
+	received_ = prio_dups_ = order_errors_ = 0;
+	executed_ = work_dups_ = 0;
+	isr_submitted_ = 0;
+
+	uint32_t t0 = cycle_counter_get();
+
+	isr_active_ = true;
+	for(uint8_t i = 0; i < n; i++)
+		xTaskNotifyGive(h_producer_[i]);
+
+	for(uint8_t i = 0; i < n; i++)
+		ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+	isr_active_ = false;
+
+	for(uint8_t i = 0; i < n; i++) {
+
+		sum.inserted += producer_[i].inserted;
+		sum.rejected += producer_[i].rejected;
+		sum.submitted += producer_[i].submitted;
+		sum.retries += producer_[i].retries;
+	}
+	sum.submitted += isr_submitted_;
+
+	start = xTaskGetTickCount();
+	while((0 != prio_queue_count() || executed_ != sum.submitted) &&
+		  pdMS_TO_TICKS(DRAIN_TIMEOUT_MS_) > (xTaskGetTickCount() - start))
+		vTaskDelay(1);
+
+	cycles = cycle_counter_get() - t0;
+	evicted = prio_queue_evicted() - evicted0;
+	ops = sum.inserted + received_ + sum.submitted + executed_;
+
+	LOGGER_INFO("[STRESS] %u prod: %lu ops/s", n,
+				(unsigned long)((0 == cycles) ? 0 : ((uint64_t)ops * SystemCoreClock) / cycles));
+	LOGGER_INFO("[STRESS] pq: %lu env %lu rec %lu desal %lu sin nodo", (unsigned long)sum.inserted,
+				(unsigned long)received_, (unsigned long)evicted, (unsigned long)sum.rejected);
+	LOGGER_INFO("[STRESS] pq: %lu dup, %lu fuera de orden", (unsigned long)prio_dups_,
+				(unsigned long)order_errors_);
+	LOGGER_INFO("[STRESS] work: %lu env (%lu isr) %lu ejec %lu dup", (unsigned long)sum.submitted,
+				(unsigned long)isr_submitted_, (unsigned long)executed_, (unsigned long)work_dups_);
+	LOGGER_INFO("[STRESS] work: %lu reintentos con cola llena", (unsigned long)sum.retries);
+
+	return sum.inserted == received_ + evicted && 0 == prio_dups_ && 0 == order_errors_ &&
+		   sum.submitted == executed_ && 0 == work_dups_;
+}
+
+static void task_ctrl_(void * argument) {
+
+	bool ok = true;
+
+	LOGGER_INFO("[STRESS] %u productores x %u items", P_, STRESS_TEST_ITEMS);
+	cycle_counter_init();
+
+	for(uint8_t n = 1; n <= P_; n++) {
+
+		if(!round_(n)) {
+
+			ok = false;
+			LOGGER_INFO("[STRESS] FALLA con %u productores", n);
+		}
+	}
+	LOGGER_INFO("[STRESS] fin: %s", ok ? "ok" : "FALLA");
+	vTaskSuspend(NULL);
+}
+
+static TaskHandle_t create_(TaskFunction_t fn, const char * name, uint16_t words, void * arg, UBaseType_t prio,
+							StackType_t * stack, StaticTask_t * tcb) {
+
+	TaskHandle_t h = NULL;
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	h = xTaskCreateStatic(fn, name, words, arg, prio, stack, tcb);
+#else
+	(void)stack;
+	(void)tcb;
+	xTaskCreate(fn, name, words, arg, prio, &h);
+#endif
+
+	if(NULL == h)
+		while(1);
+	task_monitor_register(h, words);
+	return h;
+}
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+#define STACK_(s)               (s)
+#define TCB_(t)                 (t)
+#else
+#define STACK_(s)               (NULL)
+#define TCB_(t)                 (NULL)
+#endif
+
+/********************** external functions definition ************************/
+bool stress_test_init(void) {
+
+	TaskHandle_t h_consumer;
+
+	h_consumer = create_(task_consumer_, "stress_cons", STRESS_TEST_STACK_SIZE, NULL, STRESS_TEST_PRIORITY,
+						 STACK_(consumer_stack_), TCB_(&consumer_tcb_));
+	prio_queue_register_consumer(h_consumer);
+
+	for(uint8_t i = 0; i < P_; i++) {
+
+		h_producer_[i] = create_(task_producer_, "stress_prod", STRESS_TEST_STACK_SIZE, (void *)(uintptr_t)i,
+								 STRESS_TEST_PRIORITY, STACK_(producer_stack_[i]), TCB_(&producer_tcb_[i]));
+	}
+	h_ctrl_ = create_(task_ctrl_, "stress_ctrl", STRESS_TEST_CTRL_STACK_SIZE, NULL, STRESS_TEST_PRIORITY + 2,
+					  STACK_(ctrl_stack_), TCB_(&ctrl_tcb_));
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("stress_test", sizeof(ctrl_tcb_) + sizeof(ctrl_stack_) + sizeof(consumer_tcb_) +
+					  sizeof(consumer_stack_) + sizeof(producer_tcb_) + sizeof(producer_stack_));
+#endif
+	return true;
+}
+
+/* Llamado desde HAL_TIM_PeriodElapsedCallback (TIM1, 1 kHz, prioridad 15). */
+void stress_test_on_tick_isr(void) {
+
+	BaseType_t woken = pdFALSE;
+
+	if(!isr_active_ || STRESS_TEST_ISR_ITEMS <= isr_submitted_)
+		return;
+
+	if(work_submit_from_isr(job_, (void *)(uintptr_t)(TASK_IDS_ + isr_submitted_), WORK_PRIO_HIGH, &woken))
+		isr_submitted_++;
+	portYIELD_FROM_ISR(woken);
+}
+
+#endif
+
+/********************** end of file ******************************************/
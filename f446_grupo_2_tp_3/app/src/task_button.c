@@ -43,25 +43,17 @@
 #include "logger.h"
 #include "dwt.h"
 
+#include "app.h"
 #include "task_button.h"
 #include "ao_ui.h"
+#include "scenario.h"
+#include "params.h"
 
 /********************** macros and definitions *******************************/
-#define TASK_PERIOD_MS_           (50)
-#define BUTTON_PULSE_TIMEOUT_     (200)
-#define BUTTON_SHORT_TIMEOUT_     (1000)
-#define BUTTON_LONG_TIMEOUT_      (2000)
+/* Periodo y umbrales: PARAM_BTN_PERIOD_MS y PARAM_BTN_*_MS (params.c). */
 
 
 /********************** internal data declaration ****************************/
-enum button_type_t {
-
-	BUTTON_TYPE_NONE,
-	BUTTON_TYPE_PULSE,
-	BUTTON_TYPE_SHORT,
-	BUTTON_TYPE_LONG,
-	BUTTON_TYPE__N,
-};
 
 /********************** internal data definition *****************************/
 static struct {
@@ -70,84 +62,9 @@ static struct {
     uint32_t counter;
 } button;
 
-
-
-/* ================================================================================================== */
-/* Agregar secuencia de entradas de testing que se quieran probar: */
-#ifdef TESTING_SIMULATION_BUTTON_INPUTS
-
-	#ifdef TESTING_ARRAY_INPUTS_1
-		static const button_type_t s_btn_seq_default[] = {
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_PULSE,
-															BUTTON_TYPE_NONE };
-	#elif defined(TESTING_ARRAY_INPUTS_2)
-		static const button_type_t s_btn_seq_default[] = {
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_PULSE,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_SHORT,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_LONG,
-															BUTTON_TYPE_NONE };
-	#elif defined(TESTING_ARRAY_INPUTS_3)
-
-		/* - Entran mas de 10 eventos y los primeros son de baja prioridad.
-		 * - Para la primer entrada (de baja prioridad) puede que OA LED reaccione y se encienda el LED.
-		 * - Las proximas entradas ocurren inmediatamente, pero OA LED solamente reacciona 10 veces mas y en orden de prioridades.
-		 * - Las entradas de este test son:
-				* 2 entradas con BAJA PRIORIDAD;
-				* 5 entradas con MEDIA;
-				* 4 entradas con ALTA.
-		 */
-		static const button_type_t s_btn_seq_default[] = {
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_LONG,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_LONG,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_SHORT,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_SHORT,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_PULSE,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_SHORT,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_SHORT,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_SHORT,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_PULSE,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_PULSE,
-															BUTTON_TYPE_NONE,
-															BUTTON_TYPE_PULSE,
-															BUTTON_TYPE_NONE };
-	#elif defined(TESTING_ARRAY_INPUTS_4)
-		static const button_type_t s_btn_seq_default[] = {
-															/* agregar secuencias.. */
-															BUTTON_TYPE_NONE };
-	#elif defined(TESTING_ARRAY_INPUTS_5)
-		static const button_type_t s_btn_seq_default[] = {
-															/* agregar secuencias.. */
-															BUTTON_TYPE_NONE };
-	#elif defined(TESTING_ARRAY_INPUTS_6)
-		static const button_type_t s_btn_seq_default[] = {
-															/* agregar secuencias.. */
-															BUTTON_TYPE_NONE };
-	#endif
-
-
-	static size_t s_btn_len  = sizeof(s_btn_seq_default) / sizeof(s_btn_seq_default[0]);	/* cantidad de elementos. */
-	static size_t s_btn_idx  = 0;		                                                    /* indice. */
-
-#endif
-/* ================================================================================================== */
-
-
 /********************** internal functions declaration ***********************/
 static void button_init_(void);
+static void button_step_(void);
 /* static button_type_t button_process_state_(bool value); */
 
 /********************** internal functions definition ************************/
@@ -164,16 +81,20 @@ static inline button_type_t button_process_state_(bool value) {
 
 	if(value) {
 
-		button.counter += TASK_PERIOD_MS_;
+		button.counter += param_get(PARAM_BTN_PERIOD_MS);
 	} else {
 
-		if(BUTTON_LONG_TIMEOUT_ <= button.counter) {
+		params_t p;
+
+		params_snapshot(&p);		/* los tres umbrales de una misma version */
+
+		if(p.v[PARAM_BTN_LONG_MS] <= button.counter) {
 
 			ret = BUTTON_TYPE_LONG;
-		} else if(BUTTON_SHORT_TIMEOUT_ <= button.counter) {
+		} else if(p.v[PARAM_BTN_SHORT_MS] <= button.counter) {
 
 			ret = BUTTON_TYPE_SHORT;
-		} else if(BUTTON_PULSE_TIMEOUT_ <= button.counter) {
+		} else if(p.v[PARAM_BTN_PULSE_MS] <= button.counter) {
 
 			ret = BUTTON_TYPE_PULSE;
 		}
@@ -184,43 +105,70 @@ static inline button_type_t button_process_state_(bool value) {
 
 #endif
 
+/* Una muestra del boton; comun a la tarea y al protothread. */
+static void button_step_(void) {
+
+	button_type_t button_type = get_button_type();
+
+	switch(button_type) {
+
+		case BUTTON_TYPE_NONE:
+			break;
+		case BUTTON_TYPE_PULSE:
+			if(ao_ui_send_event(MSG_EVENT_BUTTON_PULSE)) {
+
+				LOGGER_INFO("[BUTTON] pulso enviado");
+			}
+			break;
+		case BUTTON_TYPE_SHORT:
+			if(ao_ui_send_event(MSG_EVENT_BUTTON_SHORT)) {
+
+				LOGGER_INFO("[BUTTON] corto enviado");
+			}
+			break;
+		case BUTTON_TYPE_LONG:
+			if(ao_ui_send_event(MSG_EVENT_BUTTON_LONG)) {
+
+				LOGGER_INFO("[BUTTON] largo enviado");
+			}
+			break;
+		default:
+			LOGGER_INFO("[BTN] error");
+			break;
+	}
+}
+
 /********************** external functions definition ************************/
 void task_button(void* argument) {
 
+	TickType_t last_wake;
+
 	button_init_();
+	last_wake = xTaskGetTickCount();
 
+	/* grilla fija: lo que tarda un muestreo (logs incluidos) no corre los
+	 * siguientes, y el grabador de eventos se puede repetir muestra a muestra */
 	while(true) {
 
-		button_type_t button_type = get_button_type();
-
-		switch(button_type) {
-
-			case BUTTON_TYPE_NONE:
-				break;
-			case BUTTON_TYPE_PULSE:
-				if(ao_ui_send_event(MSG_EVENT_BUTTON_PULSE))
-					LOGGER_INFO("[BUTTON] pulso enviado");
-				break;
-			case BUTTON_TYPE_SHORT:
-				if(ao_ui_send_event(MSG_EVENT_BUTTON_SHORT))
-					LOGGER_INFO("[BUTTON] corto enviado");
-				break;
-			case BUTTON_TYPE_LONG:
-				if(ao_ui_send_event(MSG_EVENT_BUTTON_LONG))
-					LOGGER_INFO("[BUTTON] largo enviado");
-				break;
-			default:
-				LOGGER_INFO("[BTN] error");
-				break;
-		}
-		vTaskDelay((TickType_t)(TASK_PERIOD_MS_ / portTICK_PERIOD_MS));
+		button_step_();
+		vTaskDelayUntil(&last_wake, (TickType_t)(param_get(PARAM_BTN_PERIOD_MS) / portTICK_PERIOD_MS));
 	}
 }
 
+#if 1 == APP_CONFIG_STACKLESS_AO
+int task_button_pt(pt_t * pt) {
 
+	PT_BEGIN(pt);
+	button_init_();
 
+	while(true) {
 
-
+		button_step_();
+		PT_DELAY(pt, pdMS_TO_TICKS(param_get(PARAM_BTN_PERIOD_MS)));
+	}
+	PT_END(pt);
+}
+#endif
 
 /* Obtener tipo de entrada boton */
 button_type_t get_button_type(void)
@@ -242,38 +190,13 @@ button_type_t get_button_type(void)
 
 	return button_process_state_(button_state);
 
-
 #else
 /* MODO TESTING (CON ENTRADAS PREESTABLECIDAS DE TIPOS DE BOTONES): ----------
  */
 
-	button_type_t r;
-
-	if(0 == s_btn_len)
-		return BUTTON_TYPE_NONE;
-
-	r = s_btn_seq_default[s_btn_idx];
-
-	if((s_btn_idx + 1) < s_btn_len)
-	{
-		s_btn_idx++;
-	}
-
-	return r;
-
+	return scenario_poll();
 
 #endif  /*¨not TESTING_SIMULATION_BUTTON_INPUTS */
 }
 
-
-
-
-
-
-
-
-
-
-
-
 /********************** end of file ******************************************/
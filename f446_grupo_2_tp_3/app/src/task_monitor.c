@@ -0,0 +1,286 @@
+/*
+ * task_monitor.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+
+#include "app.h"
+#include "task_monitor.h"
+#include "heap_trace.h"
+#include "mem_pool.h"
+#include "trace_rec.h"
+#include "cpu_load.h"
+#include "low_power.h"
+#include "vtime.h"
+#include "work_queue.h"
+#include "ao_sched.h"
+#include "event_rec.h"
+#include "flash_log.h"
+#include "ao_led.h"
+
+/********************** macros and definitions *******************************/
+#define TASK_STACK_SIZE_        (192)
+#define MAX_TASKS_              (TASK_MONITOR_CONFIG_MAX_TASKS)
+
+typedef struct {
+
+	TaskHandle_t handle;
+	uint16_t stack_words;
+} stack_size_t;
+
+typedef struct {
+
+	TaskHandle_t handle;
+	task_monitor_entry_t info;
+} monitor_slot_t;
+
+/********************** internal data definition *****************************/
+static bool monitor_running = false;
+static stack_size_t stack_sizes_[MAX_TASKS_];	/* tamanos informados por cada modulo */
+static uint8_t stack_sizes_n_;
+static monitor_slot_t slots_[MAX_TASKS_];
+static uint8_t slots_n_;
+static uint32_t alarms_;
+static TaskStatus_t task_status_[MAX_TASKS_];	/* fuera del stack: ~36 B por tarea */
+static uint32_t holds_prev_;					/* encendidos cumplidos en el reporte anterior */
+static TickType_t holds_prev_tick_;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static StaticTask_t task_monitor_tcb_;
+static StackType_t task_monitor_stack_[TASK_STACK_SIZE_];
+#endif
+
+/********************** internal functions declaration ***********************/
+static void task_monitor(void *argument);
+static uint16_t stack_size_of_(TaskHandle_t task);
+static monitor_slot_t * slot_of_(TaskHandle_t task, const char * name);
+static void sample_(void);
+static void report_(void);
+
+/********************** internal functions definition ************************/
+static uint16_t stack_size_of_(TaskHandle_t task) {
+
+	for(uint8_t i = 0; i < stack_sizes_n_; i++) {
+
+		if(stack_sizes_[i].handle == task)
+			return stack_sizes_[i].stack_words;
+	}
+	return configMINIMAL_STACK_SIZE;	/* tareas de CubeMX y la idle usan el minimo */
+}
+
+static monitor_slot_t * slot_of_(TaskHandle_t task, const char * name) {
+
+	for(uint8_t i = 0; i < slots_n_; i++) {
+
+		if(slots_[i].handle == task)
+			return &slots_[i];
+	}
+
+	if(MAX_TASKS_ <= slots_n_)
+		return NULL;
+
+	monitor_slot_t * slot = &slots_[slots_n_];
+
+	slot->handle = task;
+	slot->info.name = name;
+	slot->info.stack_words = stack_size_of_(task);
+	slot->info.min_free_words = UINT16_MAX;
+	slot->info.alarm = false;
+	taskENTER_CRITICAL();
+	slots_n_++;
+	taskEXIT_CRITICAL();
+	return slot;
+}
+
+static void sample_(void) {
+
+	UBaseType_t n = uxTaskGetSystemState(task_status_, MAX_TASKS_, NULL);
+
+	for(UBaseType_t i = 0; i < n; i++) {
+
+		monitor_slot_t * slot = slot_of_(task_status_[i].xHandle, task_status_[i].pcTaskName);
+		uint16_t free_words = (uint16_t)task_status_[i].usStackHighWaterMark;
+
+		if(NULL == slot || free_words >= slot->info.min_free_words)
+			continue;
+
+		/* usado + margen (nunca menos que el umbral de alarma), redondeado a 8 palabras */
+		uint16_t used = (slot->info.stack_words > free_words) ? (slot->info.stack_words - free_words) : 0;
+		uint16_t margin = (used * TASK_MONITOR_CONFIG_MARGIN_PCT) / 100;
+
+		if(TASK_MONITOR_CONFIG_ALARM_WORDS > margin)
+			margin = TASK_MONITOR_CONFIG_ALARM_WORDS;
+
+		taskENTER_CRITICAL();
+		slot->info.min_free_words = free_words;
+		slot->info.recommended_words = (used + margin + 7) & ~7;
+		taskEXIT_CRITICAL();
+
+		if(!slot->info.alarm && TASK_MONITOR_CONFIG_ALARM_WORDS > free_words) {
+
+			slot->info.alarm = true;
+			alarms_++;
+			LOGGER_INFO("[MON] ALERTA stack %s: %u libres", slot->info.name, free_words);
+#if 1 == FLASH_LOG_CONFIG_ENABLE
+			flash_log_fault(FLASH_LOG_FAULT_STACK, free_words, slot->info.name);
+#endif
+		}
+	}
+}
+
+static void report_(void) {
+
+#if 1 == CPU_LOAD_CONFIG_ENABLE
+	cpu_load_t load;
+
+	if(cpu_load_get(&load)) {
+
+		LOGGER_INFO("[MON] CPU 1s %u 10s %u 60s %u (x0.1%%)", load.load_1s_pm, load.load_10s_pm,
+					load.load_60s_pm);
+	}
+#endif
+	work_stats_t work;
+	uint32_t holds = ao_led_get_holds_done();
+	TickType_t now = xTaskGetTickCount();
+	uint32_t window_ms = (now - holds_prev_tick_) * portTICK_PERIOD_MS;
+	uint32_t holds_mps = (0 == window_ms) ? 0 : (uint32_t)(((uint64_t)(holds - holds_prev_) * 1000000) / window_ms);
+
+	/* ritmo de vaciado de AO LED en la ventana del reporte, en milesimas por segundo */
+	LOGGER_INFO("[MON] LED %lu encendidos, %lu.%03lu /s", (unsigned long)holds, (unsigned long)(holds_mps / 1000),
+				(unsigned long)(holds_mps % 1000));
+	holds_prev_ = holds;
+	holds_prev_tick_ = now;
+
+	work_get_stats(&work);
+	LOGGER_INFO("[MON] trabajos %lu ejec, %lu descartados", (unsigned long)work.executed,
+				(unsigned long)(work.dropped[WORK_PRIO_HIGH] + work.dropped[WORK_PRIO_NORMAL] +
+								work.dropped[WORK_PRIO_LOW]));
+#if 1 == APP_CONFIG_STACKLESS_AO
+	ao_sched_stats_t sched;
+
+	ao_sched_get_stats(&sched);
+	LOGGER_INFO("[MON] AO: %u en %u B, vuelta max %lu cic", sched.ao_n, sched.ram_bytes,
+				(unsigned long)sched.pass_cycles_max);
+#endif
+#if (1 == configAPP_VIRTUAL_TIME)
+	vtime_stats_t vt;
+
+	vtime_get_stats(&vt);
+	LOGGER_INFO("[MON] t sim %lu ms, real %lu ms, %lu saltos", (unsigned long)vt.virtual_ms,
+				(unsigned long)vt.real_ms, (unsigned long)vt.jumps);
+#elif (1 == configAPP_TICKLESS_IDLE)
+	low_power_stats_t lp;
+
+	low_power_get_stats(&lp);
+	LOGGER_INFO("[MON] sueno %u x0.1%%, %u desp/s, %lu tempranos", lp.residency_pm, lp.wakeups_per_s,
+				(unsigned long)lp.early_wakeups);
+#endif
+
+	for(uint8_t i = 0; i < slots_n_; i++) {
+
+		task_monitor_entry_t * info = &slots_[i].info;
+
+		LOGGER_INFO("[MON] %s: %u pal, min libre %u, rec %u", info->name, info->stack_words,
+					info->min_free_words, info->recommended_words);
+	}
+#if (1 == configAPP_HEAP_TRACE)
+	heap_trace_dump();
+#endif
+#if 1 == MEM_POOL_CONFIG_ENABLE
+	mem_pool_dump();
+#endif
+}
+
+static void task_monitor(void *argument) {
+
+	uint32_t samples = 0;
+	TickType_t last_wake = xTaskGetTickCount();
+
+	LOGGER_INFO("[MON] tarea iniciada");
+
+	while(true) {
+
+		vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(TASK_MONITOR_CONFIG_PERIOD_MS));
+		sample_();
+
+		if(0 == (++samples % TASK_MONITOR_CONFIG_REPORT_EVERY))
+			report_();
+#if (1 == configAPP_KERNEL_TRACE)
+		/* una sola instantanea por arranque; trace_rec_start() la rearma */
+		if(trace_rec_is_full())
+			trace_rec_dump();
+#endif
+#if 1 == EVENT_REC_CONFIG_ENABLE
+		/* rechazo o backlog: la historia que llevo hasta ahi */
+		if(event_rec_triggered())
+			event_rec_dump();
+#endif
+	}
+}
+
+/********************** external functions definition ************************/
+bool task_monitor_init(void) {
+
+	TaskHandle_t h_task = NULL;
+
+	if(monitor_running)
+		return true;
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	h_task = xTaskCreateStatic(task_monitor, "task_monitor", TASK_STACK_SIZE_, NULL, tskIDLE_PRIORITY,
+							   task_monitor_stack_, &task_monitor_tcb_);
+#else
+	xTaskCreate(task_monitor, "task_monitor", TASK_STACK_SIZE_, NULL, tskIDLE_PRIORITY, &h_task);
+#endif
+
+	if(NULL == h_task) {
+
+		LOGGER_INFO("[MON] error en task_monitor_init().");
+		return false;
+	}
+	task_monitor_register(h_task, TASK_STACK_SIZE_);
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("task_monitor", sizeof(task_monitor_tcb_) + sizeof(task_monitor_stack_) + sizeof(task_status_));
+#endif
+	monitor_running = true;
+	return true;
+}
+
+void task_monitor_register(TaskHandle_t task, uint16_t stack_words) {
+
+	if(NULL == task || MAX_TASKS_ <= stack_sizes_n_)
+		return;
+
+	stack_sizes_[stack_sizes_n_].handle = task;
+	stack_sizes_[stack_sizes_n_].stack_words = stack_words;
+	stack_sizes_n_++;
+}
+
+uint8_t task_monitor_get(task_monitor_entry_t * entries, uint8_t max) {
+
+	uint8_t n;
+
+	taskENTER_CRITICAL();
+	n = (slots_n_ < max) ? slots_n_ : max;
+
+	for(uint8_t i = 0; i < n; i++)
+		entries[i] = slots_[i].info;
+	taskEXIT_CRITICAL();
+	return n;
+}
+
+uint32_t task_monitor_get_alarms(void) {
+
+	return alarms_;
+}
+
+/********************** end of file ******************************************/
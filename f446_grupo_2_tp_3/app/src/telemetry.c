@@ -0,0 +1,293 @@
+/*
+ * telemetry.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+
+#include "app.h"
+#include "ao_ui.h"
+#include "priority_queue.h"
+#include "ao_led.h"
+#include "work_queue.h"
+#include "cpu_load.h"
+#include "task_monitor.h"
+#include "uart_io.h"
+#include "crc16.h"
+#include "params.h"
+#include "telemetry.h"
+
+#if 1 == TELEMETRY_CONFIG_ENABLE
+
+/********************** macros and definitions *******************************/
+#define TASK_REC_SIZE_          (TELEMETRY_CONFIG_NAME_LEN + 6)
+#define RAW_MAX_                (2 + 1 + TELEMETRY_CONFIG_MAX_TASKS * TASK_REC_SIZE_ + 2)
+#define COBS_MAX_(n)            ((n) + (n) / 254 + 1)
+#define WIRE_MAX_               (COBS_MAX_(RAW_MAX_) + 2)
+#define TX_TIMEOUT_             (pdMS_TO_TICKS(100))
+
+typedef struct {
+
+	uint8_t * buf;
+	uint16_t n;
+} writer_t;
+
+typedef struct {
+
+	UBaseType_t number;			/* xTaskNumber: identifica la tarea entre muestras */
+	uint32_t run_time;
+} run_prev_t;
+
+/********************** internal data definition *****************************/
+static uint8_t raw_[RAW_MAX_];
+static uint8_t wire_[WIRE_MAX_];
+static uint8_t seq_;
+static TaskStatus_t status_[TELEMETRY_CONFIG_MAX_TASKS];
+static run_prev_t prev_[TELEMETRY_CONFIG_MAX_TASKS];
+static uint8_t prev_n_;
+static uint32_t prev_total_;
+static uint32_t frames_failed_;
+static uint32_t params_sent_ = UINT32_MAX;	/* version de parametros ya enviada */
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static StaticTask_t task_tlm_tcb_;
+static StackType_t task_tlm_stack_[TELEMETRY_CONFIG_STACK_SIZE];
+#endif
+
+/********************** internal functions definition ************************/
+static void put_u8_(writer_t * w, uint8_t v) {
+
+	w->buf[w->n++] = v;
+}
+
+static void put_u16_(writer_t * w, uint16_t v) {
+
+	put_u8_(w, (uint8_t)v);
+	put_u8_(w, (uint8_t)(v >> 8));
+}
+
+static void put_u32_(writer_t * w, uint32_t v) {
+
+	put_u16_(w, (uint16_t)v);
+	put_u16_(w, (uint16_t)(v >> 16));
+}
+
+/* COBS: reemplaza cada 0x00 por la distancia al proximo; out >= COBS_MAX_(n). */
+static uint16_t cobs_encode_(const uint8_t * in, uint16_t n, uint8_t * out) {
+
+	uint16_t code_pos = 0;
+	uint16_t o = 1;
+	uint8_t code = 1;
+
+	for(uint16_t i = 0; i < n; i++) {
+
+		if(0 == in[i]) {
+
+			out[code_pos] = code;
+			code_pos = o++;
+			code = 1;
+		} else {
+
+			out[o++] = in[i];
+
+			if(0xFF == ++code) {
+
+				out[code_pos] = code;
+				code_pos = o++;
+				code = 1;
+			}
+		}
+	}
+	out[code_pos] = code;
+	return o;
+}
+
+static writer_t begin_(telemetry_type_t type) {
+
+	writer_t w = {raw_, 0};
+
+	put_u8_(&w, (uint8_t)type);
+	put_u8_(&w, seq_++);
+	return w;
+}
+
+static void send_(writer_t * w) {
+
+	uint16_t len;
+
+	put_u16_(w, crc16_update(CRC16_INIT, w->buf, w->n));
+	wire_[0] = 0;
+	len = cobs_encode_(w->buf, w->n, &wire_[1]);
+	wire_[1 + len] = 0;
+
+	if(!uart_io_write(wire_, len + 2, TX_TIMEOUT_))
+		frames_failed_++;
+}
+
+static void send_sys_(void) {
+
+	writer_t w = begin_(TELEMETRY_SYS);
+	work_stats_t work;
+	uint16_t cpu_pm = 0xFFFF;
+#if 1 == CPU_LOAD_CONFIG_ENABLE
+	cpu_load_t load;
+
+	if(cpu_load_get(&load))
+		cpu_pm = load.load_1s_pm;
+#endif
+	work_get_stats(&work);
+
+	put_u32_(&w, xTaskGetTickCount());
+	put_u16_(&w, cpu_pm);
+	put_u32_(&w, xPortGetFreeHeapSize());
+	put_u32_(&w, xPortGetMinimumEverFreeHeapSize());
+	put_u8_(&w, ao_ui_get_queue_depth());
+	put_u8_(&w, (uint8_t)prio_queue_count());
+	put_u32_(&w, prio_queue_evicted());
+
+	for(uint8_t e = 0; e < MSG_EVENT__N; e++)
+		put_u32_(&w, ao_ui_get_rejected((msg_event_t)e));
+	put_u32_(&w, work.dropped[WORK_PRIO_HIGH] + work.dropped[WORK_PRIO_NORMAL] + work.dropped[WORK_PRIO_LOW]);
+	put_u32_(&w, work.executed);
+	put_u32_(&w, task_monitor_get_alarms());
+	put_u32_(&w, uart_io_get_tx_bytes());
+	put_u32_(&w, frames_failed_);
+	put_u32_(&w, ao_led_get_holds_done());
+	send_(&w);
+}
+
+/* CPU por tarea: diferencia de ulRunTimeCounter (CYCCNT) contra la muestra anterior. */
+static uint32_t run_delta_(const TaskStatus_t * st) {
+
+	for(uint8_t i = 0; i < prev_n_; i++) {
+
+		if(prev_[i].number == st->xTaskNumber)
+			return st->ulRunTimeCounter - prev_[i].run_time;
+	}
+	return 0;
+}
+
+static void send_tasks_(void) {
+
+	writer_t w = begin_(TELEMETRY_TASKS);
+	uint32_t total = 0;
+	UBaseType_t n = uxTaskGetSystemState(status_, TELEMETRY_CONFIG_MAX_TASKS, &total);
+	uint32_t total_delta = total - prev_total_;
+
+	put_u8_(&w, (uint8_t)n);
+	for(UBaseType_t i = 0; i < n; i++) {
+
+		const TaskStatus_t * st = &status_[i];
+		char name[TELEMETRY_CONFIG_NAME_LEN] = {0};
+		uint32_t delta = run_delta_(st);
+
+		strncpy(name, st->pcTaskName, sizeof(name));
+		memcpy(&w.buf[w.n], name, sizeof(name));
+		w.n += sizeof(name);
+		put_u8_(&w, (uint8_t)st->uxCurrentPriority);
+		put_u8_(&w, (uint8_t)st->eCurrentState);
+		put_u16_(&w, (0 == total_delta) ? 0 : (uint16_t)(((uint64_t)delta * 1000) / total_delta));
+		put_u16_(&w, st->usStackHighWaterMark);
+	}
+
+	for(UBaseType_t i = 0; i < n; i++) {
+
+		prev_[i].number = status_[i].xTaskNumber;
+		prev_[i].run_time = status_[i].ulRunTimeCounter;
+	}
+	prev_n_ = (uint8_t)n;
+	prev_total_ = total;
+	send_(&w);
+}
+
+static void send_latency_(void) {
+
+	writer_t w = begin_(TELEMETRY_LATENCY);
+	uint32_t hist[AO_UI_LATENCY_BUCKETS];
+	uint32_t avg;
+	uint32_t max;
+
+	ao_ui_get_latency(&avg, &max);
+	ao_ui_get_latency_hist(hist);
+
+	put_u32_(&w, SystemCoreClock);
+	put_u32_(&w, avg);
+	put_u32_(&w, max);
+	put_u8_(&w, AO_UI_LATENCY_BUCKETS);
+	for(uint8_t i = 0; i < AO_UI_LATENCY_BUCKETS; i++)
+		put_u32_(&w, hist[i]);
+	send_(&w);
+}
+
+static void send_params_(void) {
+
+	uint32_t version = params_version();
+	writer_t w;
+	params_t p;
+
+	if(version == params_sent_)
+		return;
+
+	params_snapshot(&p);
+	w = begin_(TELEMETRY_PARAMS);
+	put_u32_(&w, version);
+	put_u8_(&w, PARAM__N);
+	for(uint8_t i = 0; i < PARAM__N; i++)
+		put_u32_(&w, p.v[i]);
+	send_(&w);
+	params_sent_ = version;
+}
+
+static void task_telemetry_(void * argument) {
+
+	TickType_t last_wake = xTaskGetTickCount();
+
+	while(true) {
+
+		vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(TELEMETRY_CONFIG_PERIOD_MS));
+		send_sys_();
+		send_tasks_();
+		send_latency_();
+		send_params_();
+	}
+}
+
+/********************** external functions definition ************************/
+bool telemetry_init(void) {
+
+	TaskHandle_t h = NULL;
+
+	if(!uart_io_init())
+		return false;
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	h = xTaskCreateStatic(task_telemetry_, "task_tlm", TELEMETRY_CONFIG_STACK_SIZE, NULL,
+						  TELEMETRY_CONFIG_PRIORITY, task_tlm_stack_, &task_tlm_tcb_);
+#else
+	xTaskCreate(task_telemetry_, "task_tlm", TELEMETRY_CONFIG_STACK_SIZE, NULL, TELEMETRY_CONFIG_PRIORITY, &h);
+#endif
+
+	if(NULL == h) {
+
+		LOGGER_INFO("[TLM] error en telemetry_init().");
+		return false;
+	}
+	task_monitor_register(h, TELEMETRY_CONFIG_STACK_SIZE);
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("telemetry", sizeof(raw_) + sizeof(wire_) + sizeof(status_) + sizeof(prev_) +
+					  sizeof(task_tlm_tcb_) + sizeof(task_tlm_stack_));
+#endif
+	return true;
+}
+
+#endif
+
+/********************** end of file ******************************************/
@@ -0,0 +1,240 @@
+/*
+ * trace_rec.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+
+#include "trace_rec.h"
+
+/********************** macros and definitions *******************************/
+#define LEN_                    (TRACE_REC_CONFIG_LEN)
+#define TID_ISR_                (0)		/* las IRQ van en su propia fila */
+#define TID_UNKNOWN_            (0xFF)
+
+/* Los hooks corren con el kernel en seccion critica o desde ISR: se protegen
+ * con la mascara de interrupciones, que anida en cualquier contexto. */
+#define REC_LOCK_()             UBaseType_t rec_mask_ = portSET_INTERRUPT_MASK_FROM_ISR()
+#define REC_UNLOCK_()           portCLEAR_INTERRUPT_MASK_FROM_ISR(rec_mask_)
+
+/********************** internal data definition *****************************/
+static trace_rec_t ring_[LEN_];
+static uint16_t ring_n_;
+static bool recording_ = false;
+static bool dumped_ = false;			/* la instantanea ya se volco */
+static const void * current_;			/* ultima tarea que entro, aun con el registro detenido */
+static const void * tids_[TRACE_REC_CONFIG_MAX_TASKS];	/* tid = indice + 1 */
+static uint8_t tids_n_;
+
+/* nombres de una palabra: tools/trace_json.py los lee */
+static const char * const ev_names_[TRACE_REC_EV__N] = {
+	[TRACE_REC_EV_SWITCH_IN] = "in",
+	[TRACE_REC_EV_SWITCH_OUT] = "out",
+	[TRACE_REC_EV_QUEUE_SEND] = "send",
+	[TRACE_REC_EV_QUEUE_RECV] = "recv",
+	[TRACE_REC_EV_BLOCK_SEND] = "block_send",
+	[TRACE_REC_EV_BLOCK_RECV] = "block_recv",
+	[TRACE_REC_EV_BLOCK_NOTIFY] = "wait_notify",
+	[TRACE_REC_EV_DELAY] = "delay",
+	[TRACE_REC_EV_NOTIFY] = "notify",
+	[TRACE_REC_EV_ISR_ENTER] = "isr_in",
+	[TRACE_REC_EV_ISR_EXIT] = "isr_out",
+};
+
+/********************** internal functions declaration ***********************/
+static void push_(uint8_t event, const void * obj, uint8_t irq);
+static uint8_t tid_of_(const void * task);
+static const char * obj_name_(const void * obj, char * buf, size_t len);
+static void dump_event_(const trace_rec_t * rec);
+
+/********************** internal functions definition ************************/
+static void push_(uint8_t event, const void * obj, uint8_t irq) {
+
+	REC_LOCK_();
+
+	if(recording_) {
+
+		trace_rec_t * rec = &ring_[ring_n_];
+
+		rec->cycles = cycle_counter_get();
+		rec->task = current_;
+		rec->obj = obj;
+		rec->event = event;
+		rec->irq = irq;
+
+		if(LEN_ <= ++ring_n_)
+			recording_ = false;
+	}
+	REC_UNLOCK_();
+}
+
+static uint8_t tid_of_(const void * task) {
+
+	if(NULL == task)
+		return TID_UNKNOWN_;
+
+	for(uint8_t i = 0; i < tids_n_; i++) {
+
+		if(tids_[i] == task)
+			return i + 1;
+	}
+
+	if(TRACE_REC_CONFIG_MAX_TASKS <= tids_n_)
+		return TID_UNKNOWN_;
+	tids_[tids_n_] = task;
+	return ++tids_n_;
+}
+
+static const char * obj_name_(const void * obj, char * buf, size_t len) {
+
+	const char * name = NULL;
+
+	if(NULL == obj)
+		return "-";
+#if 0 < configQUEUE_REGISTRY_SIZE
+	name = pcQueueGetName((QueueHandle_t)obj);
+#endif
+
+	if(NULL == name) {
+
+		snprintf(buf, len, "%p", obj);
+		name = buf;
+	}
+	return name;
+}
+
+/* Una linea por registro: "[TRACE] r ciclos tid evento irq objeto". En notify
+ * el objeto es la tarea notificada ("t" + tid). */
+static void dump_event_(const trace_rec_t * rec) {
+
+	uint8_t tid = (TRACE_REC_EV_ISR_ENTER == rec->event || TRACE_REC_EV_ISR_EXIT == rec->event) ?
+				  TID_ISR_ : tid_of_(rec->task);
+	char buf[12];
+	const char * obj;
+
+	if(TRACE_REC_EV_NOTIFY == rec->event) {
+
+		snprintf(buf, sizeof(buf), "t%u", tid_of_(rec->obj));
+		obj = buf;
+	} else {
+
+		obj = obj_name_(rec->obj, buf, sizeof(buf));
+	}
+	LOGGER_INFO("[TRACE] r %lu %u %s %u %s", (unsigned long)rec->cycles, tid,
+				(TRACE_REC_EV__N > rec->event) ? ev_names_[rec->event] : "?", rec->irq, obj);
+}
+
+/********************** external functions definition ************************/
+void trace_rec_init(void) {
+
+	trace_rec_start();
+	LOGGER_INFO("[TRACE] %u registros, %u B", LEN_, (unsigned)sizeof(ring_));
+}
+
+void trace_rec_start(void) {
+
+	REC_LOCK_();
+	ring_n_ = 0;
+	recording_ = true;
+	dumped_ = false;
+	REC_UNLOCK_();
+}
+
+void trace_rec_stop(void) {
+
+	REC_LOCK_();
+	recording_ = false;
+	REC_UNLOCK_();
+}
+
+/* Lleno y todavia sin volcar. */
+bool trace_rec_is_full(void) {
+
+	return !dumped_ && LEN_ <= ring_n_;
+}
+
+uint16_t trace_rec_get(trace_rec_t * records, uint16_t max) {
+
+	uint16_t n;
+
+	REC_LOCK_();
+	n = (ring_n_ < max) ? ring_n_ : max;
+	memcpy(records, ring_, n * sizeof(trace_rec_t));
+	REC_UNLOCK_();
+	return n;
+}
+
+/* Vuelca el anillo en texto, una linea por registro, para convertirlo en la PC
+ * con tools/trace_json.py (Chrome trace JSON). Detiene el registro: el logger
+ * mismo generaria eventos. Cada registro se copia bajo el lock y se imprime
+ * fuera de el; solo queda la seccion critica corta de cada linea del logger. */
+void trace_rec_dump(void) {
+
+	uint16_t n;
+
+	REC_LOCK_();
+	recording_ = false;
+	dumped_ = true;
+	n = ring_n_;
+	REC_UNLOCK_();
+	tids_n_ = 0;
+
+	LOGGER_INFO("[TRACE] inicio %u %lu", n, (unsigned long)cycles_per_us);
+
+	for(uint16_t i = 0; i < n; i++) {
+
+		trace_rec_t rec;
+
+		REC_LOCK_();
+		rec = ring_[i];
+		REC_UNLOCK_();
+		dump_event_(&rec);
+	}
+
+	/* nombres de fila: una linea por tarea vista */
+	for(uint8_t i = 0; i < tids_n_; i++) {
+
+		LOGGER_INFO("[TRACE] tarea %u %s", i + 1, pcTaskGetName((TaskHandle_t)tids_[i]));
+	}
+	LOGGER_INFO("[TRACE] fin");
+}
+
+void trace_rec_switch_in(const void * task) {
+
+	current_ = task;
+	push_(TRACE_REC_EV_SWITCH_IN, NULL, 0);
+}
+
+void trace_rec_switch_out(const void * task) {
+
+	(void)task;		/* es current_ */
+	push_(TRACE_REC_EV_SWITCH_OUT, NULL, 0);
+}
+
+void trace_rec_kernel(uint8_t event, const void * obj) {
+
+	push_(event, obj, 0);
+}
+
+void trace_rec_isr_enter(uint8_t irq) {
+
+	push_(TRACE_REC_EV_ISR_ENTER, NULL, irq);
+}
+
+void trace_rec_isr_exit(uint8_t irq) {
+
+	push_(TRACE_REC_EV_ISR_EXIT, NULL, irq);
+}
+
+/********************** end of file ******************************************/
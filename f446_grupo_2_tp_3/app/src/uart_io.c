@@ -0,0 +1,246 @@
+/*
+ * uart_io.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "stream_buffer.h"
+#include "logger.h"
+
+#include "app.h"
+#include "uart_io.h"
+
+#if 1 == UART_IO_CONFIG_ENABLE
+
+/********************** external data declaration ****************************/
+extern UART_HandleTypeDef huart2;
+
+/********************** internal data definition *****************************/
+static DMA_HandleTypeDef hdma_tx_;
+static DMA_HandleTypeDef hdma_rx_;
+static SemaphoreHandle_t tx_mutex_;
+static SemaphoreHandle_t tx_done_;		/* lo da HAL_UART_TxCpltCallback */
+static StreamBufferHandle_t rx_stream_;
+static uint8_t rx_dma_buf_[UART_IO_CONFIG_RX_DMA_LEN];
+static uint16_t rx_pos_;				/* proxima posicion del buffer circular a copiar */
+static uint32_t tx_bytes_;
+static uint32_t rx_bytes_;
+static uint32_t rx_dropped_;			/* no entraron en rx_stream_ (lector atrasado) */
+static bool uart_io_initialized_ = false;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static StaticSemaphore_t tx_mutex_ctrl_;
+static StaticSemaphore_t tx_done_ctrl_;
+static StaticStreamBuffer_t rx_stream_ctrl_;
+static uint8_t rx_stream_storage_[UART_IO_CONFIG_RX_STREAM_LEN + 1];
+#endif
+
+/********************** internal functions definition ************************/
+static bool rx_start_(void) {
+
+	rx_pos_ = 0;
+	return (HAL_OK == HAL_UARTEx_ReceiveToIdle_DMA(&huart2, rx_dma_buf_, sizeof(rx_dma_buf_)));
+}
+
+/* Desde ISR: pasa rx_dma_buf_[from, to) al stream buffer. */
+static void rx_push_(uint16_t from, uint16_t to, BaseType_t * woken) {
+
+	size_t n = to - from;
+	size_t sent;
+
+	if(0 == n)
+		return;
+	sent = xStreamBufferSendFromISR(rx_stream_, &rx_dma_buf_[from], n, woken);
+	rx_bytes_ += sent;
+	rx_dropped_ += n - sent;
+}
+
+/********************** external functions definition ************************/
+bool uart_io_init(void) {
+
+	if(uart_io_initialized_)
+		return true;
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	tx_mutex_ = xSemaphoreCreateMutexStatic(&tx_mutex_ctrl_);
+	tx_done_ = xSemaphoreCreateBinaryStatic(&tx_done_ctrl_);
+	rx_stream_ = xStreamBufferCreateStatic(sizeof(rx_stream_storage_), 1, rx_stream_storage_, &rx_stream_ctrl_);
+#else
+	tx_mutex_ = xSemaphoreCreateMutex();
+	tx_done_ = xSemaphoreCreateBinary();
+	rx_stream_ = xStreamBufferCreate(UART_IO_CONFIG_RX_STREAM_LEN, 1);
+#endif
+
+	if(NULL == tx_mutex_ || NULL == tx_done_ || NULL == rx_stream_) {
+
+		LOGGER_INFO("[UART] error en uart_io_init().");
+		return false;
+	}
+
+	/* USART2_TX: DMA1 Stream6 canal 4 */
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	hdma_tx_.Instance = DMA1_Stream6;
+	hdma_tx_.Init.Channel = DMA_CHANNEL_4;
+	hdma_tx_.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdma_tx_.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma_tx_.Init.MemInc = DMA_MINC_ENABLE;
+	hdma_tx_.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma_tx_.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdma_tx_.Init.Mode = DMA_NORMAL;
+	hdma_tx_.Init.Priority = DMA_PRIORITY_LOW;
+	hdma_tx_.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+
+	if(HAL_OK != HAL_DMA_Init(&hdma_tx_)) {
+
+		LOGGER_INFO("[UART] error en HAL_DMA_Init() de TX.");
+		return false;
+	}
+	__HAL_LINKDMA(&huart2, hdmatx, hdma_tx_);
+
+	/* USART2_RX: DMA1 Stream5 canal 4, circular */
+	hdma_rx_.Instance = DMA1_Stream5;
+	hdma_rx_.Init = hdma_tx_.Init;
+	hdma_rx_.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	hdma_rx_.Init.Mode = DMA_CIRCULAR;
+
+	if(HAL_OK != HAL_DMA_Init(&hdma_rx_)) {
+
+		LOGGER_INFO("[UART] error en HAL_DMA_Init() de RX.");
+		return false;
+	}
+	__HAL_LINKDMA(&huart2, hdmarx, hdma_rx_);
+
+	HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, UART_IO_IRQ_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+	HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, UART_IO_IRQ_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+	HAL_NVIC_SetPriority(USART2_IRQn, UART_IO_IRQ_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(USART2_IRQn);
+
+	if(!rx_start_()) {
+
+		LOGGER_INFO("[UART] error al iniciar la recepcion.");
+		return false;
+	}
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("uart_io", sizeof(hdma_tx_) + sizeof(hdma_rx_) + sizeof(tx_mutex_ctrl_) + sizeof(tx_done_ctrl_) +
+					  sizeof(rx_dma_buf_) + sizeof(rx_stream_ctrl_) + sizeof(rx_stream_storage_));
+#endif
+	uart_io_initialized_ = true;
+	return true;
+}
+
+/* Bloquea hasta que sale el ultimo byte: data puede vivir en el stack. */
+bool uart_io_write(const uint8_t * data, uint16_t len, TickType_t timeout) {
+
+	bool ok;
+
+	if(!uart_io_initialized_ || NULL == data || 0 == len)
+		return false;
+
+	if(pdTRUE != xSemaphoreTake(tx_mutex_, timeout))
+		return false;
+
+	xSemaphoreTake(tx_done_, 0);		/* descarta un aviso viejo de una escritura abortada */
+	ok = (HAL_OK == HAL_UART_Transmit_DMA(&huart2, (uint8_t *)data, len));
+
+	if(ok)
+		ok = (pdTRUE == xSemaphoreTake(tx_done_, timeout));
+
+	if(ok) {
+
+		tx_bytes_ += len;
+	} else {
+
+		HAL_UART_AbortTransmit(&huart2);
+	}
+	xSemaphoreGive(tx_mutex_);
+	return ok;
+}
+
+/* Devuelve lo que haya (hasta len) apenas llega al menos un byte. */
+size_t uart_io_read(uint8_t * data, size_t len, TickType_t timeout) {
+
+	if(!uart_io_initialized_ || NULL == data || 0 == len)
+		return 0;
+	return xStreamBufferReceive(rx_stream_, data, len, timeout);
+}
+
+uint32_t uart_io_get_tx_bytes(void) {
+
+	return tx_bytes_;
+}
+
+uint32_t uart_io_get_rx_bytes(void) {
+
+	return rx_bytes_;
+}
+
+uint32_t uart_io_get_rx_dropped(void) {
+
+	return rx_dropped_;
+}
+
+void uart_io_dma_tx_irq(void) {
+
+	HAL_DMA_IRQHandler(&hdma_tx_);
+}
+
+void uart_io_dma_rx_irq(void) {
+
+	HAL_DMA_IRQHandler(&hdma_rx_);
+}
+
+void uart_io_irq(void) {
+
+	HAL_UART_IRQHandler(&huart2);
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef * huart) {
+
+	BaseType_t woken = pdFALSE;
+
+	if(USART2 != huart->Instance)
+		return;
+	xSemaphoreGiveFromISR(tx_done_, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+/* Media vuelta, vuelta completa (pos = largo del buffer) o IDLE: pos es la
+ * posicion de escritura de la DMA dentro de rx_dma_buf_. */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef * huart, uint16_t pos) {
+
+	BaseType_t woken = pdFALSE;
+
+	if(USART2 != huart->Instance)
+		return;
+
+	if(pos < rx_pos_) {
+
+		/* la DMA dio la vuelta sin avisar el fin de buffer (no deberia pasar) */
+		rx_push_(rx_pos_, sizeof(rx_dma_buf_), &woken);
+		rx_pos_ = 0;
+	}
+	rx_push_(rx_pos_, pos, &woken);
+	rx_pos_ = (sizeof(rx_dma_buf_) == pos) ? 0 : pos;
+	portYIELD_FROM_ISR(woken);
+}
+
+/* Un error de recepcion (ruido, overrun) detiene la DMA de RX: se reinicia. */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef * huart) {
+
+	if(USART2 != huart->Instance)
+		return;
+	if(HAL_UART_STATE_READY == huart->RxState)
+		rx_start_();
+}
+
+#endif
+
+/********************** end of file ******************************************/
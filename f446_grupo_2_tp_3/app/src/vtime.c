@@ -0,0 +1,49 @@
+/*
+ * vtime.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+
+#include "vtime.h"
+
+/********************** internal data definition *****************************/
+static vtime_stats_t stats_;
+
+/********************** external functions definition ************************/
+/* Reemplaza a portSUPPRESS_TICKS_AND_SLEEP: corre en el idle con el scheduler
+ * suspendido. Se salta un tick menos que el plazo; el ultimo lo da SysTick,
+ * asi el desbloqueo pasa por xTaskIncrementTick como en una espera real. */
+void vtime_skip(uint32_t expected_ticks) {
+
+	__disable_irq();
+	__DSB();
+	__ISB();
+
+	if(eStandardSleep == eTaskConfirmSleepModeStatus() && 1 < expected_ticks) {
+
+		vTaskStepTick(expected_ticks - 1);
+		stats_.jumps++;
+		stats_.skipped_ticks += expected_ticks - 1;
+	}
+	__enable_irq();
+}
+
+void vtime_get_stats(vtime_stats_t * stats) {
+
+	taskENTER_CRITICAL();
+	*stats = stats_;
+	taskEXIT_CRITICAL();
+
+	stats->virtual_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+	stats->real_ms = HAL_GetTick();
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,268 @@
+/*
+ * work_queue.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+
+#include "app.h"
+#include "task_monitor.h"
+#include "work_queue.h"
+
+/********************** macros and definitions *******************************/
+#define LEN_                    (WORK_CONFIG_QUEUE_LEN)
+#define MASK_                   (LEN_ - 1)
+#define JOBS_MAX_               (LEN_ * WORK_PRIO__N)
+
+#if 0 != (LEN_ & MASK_)
+#error "WORK_CONFIG_QUEUE_LEN debe ser potencia de 2"
+#endif
+
+/* Cola acotada de Vyukov: cada celda lleva un numero de secuencia que indica
+ * si esta libre para la vuelta 'pos' (seq == pos) o publicada (seq == pos + 1). */
+typedef struct {
+
+	uint32_t seq;
+	work_fn_t fn;
+	void * arg;
+} cell_t;
+
+typedef struct {
+
+	cell_t cells[LEN_];
+	uint32_t enqueue_pos;
+	uint32_t dequeue_pos;
+} ring_t;
+
+/********************** internal data definition *****************************/
+static ring_t rings_[WORK_PRIO__N];
+static SemaphoreHandle_t jobs_sem_;		/* un token por trabajo publicado */
+static uint32_t submitted_[WORK_PRIO__N];
+static uint32_t dropped_[WORK_PRIO__N];
+static uint32_t executed_;
+static uint8_t workers_;
+static bool work_initialized_ = false;
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+static StaticSemaphore_t jobs_sem_ctrl_;
+#if 0 < WORK_CONFIG_EXTRA_WORKERS
+static StaticTask_t worker_tcb_[WORK_CONFIG_EXTRA_WORKERS];
+static StackType_t worker_stack_[WORK_CONFIG_EXTRA_WORKERS][WORK_CONFIG_STACK_SIZE];
+#endif
+#endif
+
+/********************** internal functions declaration ***********************/
+static bool ring_push_(ring_t * ring, work_fn_t fn, void * arg);
+static bool ring_pop_(ring_t * ring, work_fn_t * fn, void ** arg);
+static bool push_(work_fn_t fn, void * arg, work_prio_t prio);
+#if 0 < WORK_CONFIG_EXTRA_WORKERS
+static void task_worker_(void * argument);
+#endif
+
+/********************** internal functions definition ************************/
+static bool ring_push_(ring_t * ring, work_fn_t fn, void * arg) {
+
+	cell_t * cell;
+	uint32_t pos = __atomic_load_n(&ring->enqueue_pos, __ATOMIC_RELAXED);
+
+	while(true) {
+
+		cell = &ring->cells[pos & MASK_];
+		int32_t diff = (int32_t)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - pos);
+
+		if(0 == diff) {
+
+			if(__atomic_compare_exchange_n(&ring->enqueue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED,
+										   __ATOMIC_RELAXED))
+				break;
+		} else if(diff < 0) {
+
+			return false;	/* llena */
+		} else {
+
+			pos = __atomic_load_n(&ring->enqueue_pos, __ATOMIC_RELAXED);
+		}
+	}
+	cell->fn = fn;
+	cell->arg = arg;
+	__atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+static bool ring_pop_(ring_t * ring, work_fn_t * fn, void ** arg) {
+
+	cell_t * cell;
+	uint32_t pos = __atomic_load_n(&ring->dequeue_pos, __ATOMIC_RELAXED);
+
+	while(true) {
+
+		cell = &ring->cells[pos & MASK_];
+		int32_t diff = (int32_t)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - (pos + 1));
+
+		if(0 == diff) {
+
+			if(__atomic_compare_exchange_n(&ring->dequeue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED,
+										   __ATOMIC_RELAXED))
+				break;
+		} else if(diff < 0) {
+
+			return false;	/* vacia */
+		} else {
+
+			pos = __atomic_load_n(&ring->dequeue_pos, __ATOMIC_RELAXED);
+		}
+	}
+	*fn = cell->fn;
+	*arg = cell->arg;
+	__atomic_store_n(&cell->seq, pos + LEN_, __ATOMIC_RELEASE);
+	return true;
+}
+
+static bool push_(work_fn_t fn, void * arg, work_prio_t prio) {
+
+	if(!work_initialized_ || NULL == fn || WORK_PRIO__N <= prio)
+		return false;
+
+	if(!ring_push_(&rings_[prio], fn, arg)) {
+
+		__atomic_fetch_add(&dropped_[prio], 1, __ATOMIC_RELAXED);
+		return false;
+	}
+	__atomic_fetch_add(&submitted_[prio], 1, __ATOMIC_RELAXED);
+	return true;
+}
+
+#if 0 < WORK_CONFIG_EXTRA_WORKERS
+static void task_worker_(void * argument) {
+
+	(void)argument;
+	work_worker_run();
+}
+#endif
+
+/********************** external functions definition ************************/
+bool work_init(void) {
+
+	if(work_initialized_)
+		return true;
+
+	for(uint8_t p = 0; p < WORK_PRIO__N; p++) {
+
+		for(uint32_t i = 0; i < LEN_; i++)
+			rings_[p].cells[i].seq = i;
+		rings_[p].enqueue_pos = 0;
+		rings_[p].dequeue_pos = 0;
+	}
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	jobs_sem_ = xSemaphoreCreateCountingStatic(JOBS_MAX_, 0, &jobs_sem_ctrl_);
+#else
+	jobs_sem_ = xSemaphoreCreateCounting(JOBS_MAX_, 0);
+#endif
+
+	if(NULL == jobs_sem_) {
+
+		LOGGER_INFO("[WORK] error en work_init().");
+		return false;
+	}
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("work_queue", sizeof(rings_) + sizeof(jobs_sem_ctrl_));
+#endif
+
+#if 0 < WORK_CONFIG_EXTRA_WORKERS
+	for(uint8_t i = 0; i < WORK_CONFIG_EXTRA_WORKERS; i++) {
+
+		TaskHandle_t h = NULL;
+
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+		h = xTaskCreateStatic(task_worker_, "task_worker", WORK_CONFIG_STACK_SIZE, NULL, WORK_CONFIG_PRIORITY,
+							  worker_stack_[i], &worker_tcb_[i]);
+#else
+		xTaskCreate(task_worker_, "task_worker", WORK_CONFIG_STACK_SIZE, NULL, WORK_CONFIG_PRIORITY, &h);
+#endif
+
+		if(NULL == h)
+			while(1);
+		task_monitor_register(h, WORK_CONFIG_STACK_SIZE);
+	}
+#if 1 == APP_CONFIG_STATIC_ALLOCATION
+	app_static_report("task_worker", sizeof(worker_tcb_) + sizeof(worker_stack_));
+#endif
+#endif
+	work_initialized_ = true;
+	return true;
+}
+
+bool work_submit(work_fn_t fn, void * arg, work_prio_t prio) {
+
+	if(!push_(fn, arg, prio))
+		return false;
+	xSemaphoreGive(jobs_sem_);
+	return true;
+}
+
+bool work_submit_from_isr(work_fn_t fn, void * arg, work_prio_t prio, BaseType_t * woken) {
+
+	if(!push_(fn, arg, prio))
+		return false;
+	xSemaphoreGiveFromISR(jobs_sem_, woken);
+	return true;
+}
+
+/* Cuerpo de cada trabajador; no retorna. Cada token del semaforo corresponde a
+ * un trabajo ya publicado, pero puede estar detras de una celda que otro
+ * productor reservo y todavia no publico: ring_pop_ la ve vacia. Ese productor
+ * puede tener menor prioridad (task_ui), y taskYIELD() no le cederia la CPU;
+ * vTaskDelay(1) si, y en el tick siguiente la celda ya esta publicada. */
+void work_worker_run(void) {
+
+	work_fn_t fn = NULL;
+	void * arg = NULL;
+
+	vTaskPrioritySet(NULL, WORK_CONFIG_PRIORITY);
+	__atomic_fetch_add(&workers_, 1, __ATOMIC_RELAXED);
+
+	while(!work_initialized_)
+		vTaskDelay(1);
+
+	while(true) {
+
+		xSemaphoreTake(jobs_sem_, portMAX_DELAY);
+
+		while(true) {
+
+			uint8_t p = 0;
+
+			while(p < WORK_PRIO__N && !ring_pop_(&rings_[p], &fn, &arg))
+				p++;
+
+			if(p < WORK_PRIO__N)
+				break;
+			vTaskDelay(1);
+		}
+		fn(arg);
+		__atomic_fetch_add(&executed_, 1, __ATOMIC_RELAXED);
+	}
+}
+
+void work_get_stats(work_stats_t * stats) {
+
+	for(uint8_t p = 0; p < WORK_PRIO__N; p++) {
+
+		stats->submitted[p] = __atomic_load_n(&submitted_[p], __ATOMIC_RELAXED);
+		stats->dropped[p] = __atomic_load_n(&dropped_[p], __ATOMIC_RELAXED);
+	}
+	stats->executed = __atomic_load_n(&executed_, __ATOMIC_RELAXED);
+	stats->workers = workers_;
+}
+
+/********************** end of file ******************************************/
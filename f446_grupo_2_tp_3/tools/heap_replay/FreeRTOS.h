@@ -0,0 +1,58 @@
+/*
+ * FreeRTOS.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Sustituto minimo de FreeRTOS.h para compilar heap_4.c y heap_tlsf.c en la PC
+ * (heap_replay). Solo lo que usan los dos asignadores; sin scheduler. */
+#ifndef HEAP_REPLAY_FREERTOS_H_
+#define HEAP_REPLAY_FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE               ((size_t)15360)		/* el del firmware en modo dinamico */
+#endif
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configAPPLICATION_ALLOCATED_HEAP    0
+#define configUSE_MALLOC_FAILED_HOOK        0
+#define configASSERT(x)                     assert(x)
+
+#define pdFALSE                             ((BaseType_t)0)
+#define pdTRUE                              ((BaseType_t)1)
+
+#define portBYTE_ALIGNMENT                  8
+#define portBYTE_ALIGNMENT_MASK             (0x0007)
+#define portMAX_DELAY                       ((TickType_t)0xFFFFFFFFu)
+
+#define mtCOVERAGE_TEST_MARKER()
+#define traceMALLOC(pvAddress, uiSize)
+#define traceFREE(pvAddress, uiSize)
+
+typedef struct xHeapStats
+{
+	size_t xAvailableHeapSpaceInBytes;
+	size_t xSizeOfLargestFreeBlockInBytes;
+	size_t xSizeOfSmallestFreeBlockInBytes;
+	size_t xNumberOfFreeBlocks;
+	size_t xMinimumEverFreeBytesRemaining;
+	size_t xNumberOfSuccessfulAllocations;
+	size_t xNumberOfSuccessfulFrees;
+} HeapStats_t;
+
+void *pvPortMalloc( size_t xWantedSize );
+void vPortFree( void *pv );
+void vPortInitialiseBlocks( void );
+size_t xPortGetFreeHeapSize( void );
+size_t xPortGetMinimumEverFreeHeapSize( void );
+void vPortGetHeapStats( HeapStats_t *pxHeapStats );
+
+#endif /* HEAP_REPLAY_FREERTOS_H_ */
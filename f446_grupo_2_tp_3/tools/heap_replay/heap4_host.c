@@ -0,0 +1,21 @@
+/*
+ * heap4_host.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* heap_4.c tal cual, con la API renombrada para convivir con heap_tlsf.c. */
+#define configAPP_HEAP_TLSF                 0
+#define pvPortMalloc                        heap4_malloc
+#define vPortFree                           heap4_free
+#define vPortInitialiseBlocks               heap4_initialise_blocks
+#define xPortGetFreeHeapSize                heap4_free_size
+#define xPortGetMinimumEverFreeHeapSize     heap4_min_ever_free
+#define vPortGetHeapStats                   heap4_stats
+
+#include "../../Middlewares/Third_Party/FreeRTOS/Source/portable/MemMang/heap_4.c"
+
+#include "heap_replay.h"
+
+const heap_replay_alloc_t heap_replay_heap4 = {"heap_4", heap4_malloc, heap4_free, heap4_stats};
@@ -0,0 +1,334 @@
+/*
+ * heap_replay.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Banco de prueba en la PC: reproduce una secuencia de pvPortMalloc/vPortFree
+ * sobre heap_4.c y heap_tlsf.c (los mismos fuentes del firmware, ver
+ * heap4_host.c y heap_tlsf_host.c) y compara el tiempo por operacion y la
+ * fragmentacion de cada uno.
+ *
+ * Compilar desde f446_grupo_2_tp_3:
+ *   gcc -O2 -Itools/heap_replay -o heap_replay tools/heap_replay/heap_replay.c \
+ *       tools/heap_replay/heap4_host.c tools/heap_replay/heap_tlsf_host.c
+ *   (-DconfigTOTAL_HEAP_SIZE=... cambia el tamano del heap, 15360 por defecto)
+ * Uso:
+ *   heap_replay log.txt           lineas "[HEAP] ev ..." del log (heap_trace_dump)
+ *   heap_replay [-n ops] [-s semilla]   carga sintetica parecida a la del firmware
+ *
+ * Los tiempos son ticks del contador de la PC (TSC en x86): sirven para
+ * comparar los dos asignadores entre si, no para estimar ciclos del micro. En
+ * la PC las cabeceras de bloque miden 16 B en vez de 8 (punteros de 64 bits). */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "heap_replay.h"
+
+/********************** macros and definitions *******************************/
+#define TARGET_HDR_SIZE_        (8)		/* cabecera de heap_4 en el micro: la traza la incluye */
+#define MAX_LIVE_               (4096)
+#define SYNTH_MAX_LIVE_         (24)
+
+typedef struct {
+
+	char op;					/* 'a' o 'f' */
+	uint32_t id;				/* puntero en el micro o numero sintetico */
+	uint32_t size;				/* pedido, sin cabecera */
+} event_t;
+
+typedef struct {
+
+	uint32_t n;
+	uint64_t total;
+	uint64_t max;
+} timing_t;
+
+typedef struct {
+
+	timing_t malloc_t;
+	timing_t free_t;
+	uint32_t failed;
+	uint32_t unknown_frees;		/* frees de bloques pedidos antes de la captura */
+	size_t min_free;
+	uint32_t frag_end_pct;
+	uint32_t frag_max_pct;
+	size_t largest_end;
+	size_t free_blocks_end;
+} result_t;
+
+/********************** internal data definition *****************************/
+static event_t * events_;
+static uint32_t events_n_;
+static uint32_t events_cap_;
+
+static uint32_t live_id_[MAX_LIVE_];
+static void * live_ptr_[MAX_LIVE_];
+static uint32_t live_n_;
+
+static uint32_t rnd_state_;
+
+/********************** internal functions definition ************************/
+static uint64_t now_(void) {
+
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static uint32_t rnd_(void) {
+
+	rnd_state_ = rnd_state_ * 1664525u + 1013904223u;
+	return rnd_state_ >> 8;
+}
+
+static void push_(char op, uint32_t id, uint32_t size) {
+
+	if(events_n_ == events_cap_) {
+
+		events_cap_ = events_cap_ ? events_cap_ * 2 : 1024;
+		events_ = realloc(events_, events_cap_ * sizeof(event_t));
+
+		if(NULL == events_) {
+
+			perror("realloc");
+			exit(1);
+		}
+	}
+	events_[events_n_].op = op;
+	events_[events_n_].id = id;
+	events_[events_n_].size = size;
+	events_n_++;
+}
+
+/* Lineas de heap_trace_dump(): "[HEAP] ev <tick> <a|f> <puntero> <bytes de bloque>". */
+static bool load_log_(const char * path) {
+
+	FILE * f = fopen(path, "r");
+	char line[256];
+
+	if(NULL == f) {
+
+		perror(path);
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), f)) {
+
+		const char * p = strstr(line, "[HEAP] ev ");
+		unsigned long tick;
+		char op;
+		char ptr[32];
+		unsigned size;
+
+		if(NULL == p || 4 != sscanf(p + 10, "%lu %c %31s %u", &tick, &op, ptr, &size) || ('a' != op && 'f' != op))
+			continue;
+		push_(op, (uint32_t)strtoul(ptr, NULL, 16), (size > TARGET_HDR_SIZE_) ? size - TARGET_HDR_SIZE_ : 1);
+	}
+	fclose(f);
+	return true;
+}
+
+/* Arranque con los objetos de vida larga del modo dinamico (TCB + stack de cada
+ * tarea, colas) y despues rotacion: nodos de la cola de prioridad (16 B), pedidos
+ * medianos y algunos grandes que se liberan en cualquier orden. */
+static void synth_(uint32_t ops, uint32_t seed) {
+
+	static const uint32_t boot_[] = {100, 512, 100, 512, 100, 512, 100, 768, 100, 768, 80, 120, 48, 48, 256};
+	uint32_t live[SYNTH_MAX_LIVE_];
+	uint32_t n = 0;
+	uint32_t next_id = 1;
+
+	rnd_state_ = seed;
+
+	for(uint32_t i = 0; i < sizeof(boot_) / sizeof(boot_[0]); i++)
+		push_('a', next_id++, boot_[i]);
+
+	for(uint32_t i = 0; i < ops; i++) {
+
+		if(0 == n || (SYNTH_MAX_LIVE_ > n && (rnd_() & 1))) {
+
+			uint32_t r = rnd_() % 100;
+			uint32_t size = (60 > r) ? 16 : (90 > r) ? 24 + (rnd_() % 200) : 256 + (rnd_() % 768);
+
+			live[n++] = next_id;
+			push_('a', next_id++, size);
+		} else {
+
+			uint32_t k = rnd_() % n;
+
+			push_('f', live[k], 0);
+			live[k] = live[--n];
+		}
+	}
+}
+
+static int live_find_(uint32_t id) {
+
+	for(uint32_t i = 0; i < live_n_; i++) {
+
+		if(live_id_[i] == id)
+			return (int)i;
+	}
+	return -1;
+}
+
+static void timing_add_(timing_t * t, uint64_t dt) {
+
+	t->n++;
+	t->total += dt;
+
+	if(dt > t->max)
+		t->max = dt;
+}
+
+static uint32_t frag_pct_(const HeapStats_t * st) {
+
+	if(0 == st->xAvailableHeapSpaceInBytes)
+		return 0;
+	return (uint32_t)(100 - (st->xSizeOfLargestFreeBlockInBytes * 100) / st->xAvailableHeapSpaceInBytes);
+}
+
+static void run_(const heap_replay_alloc_t * a, result_t * r) {
+
+	HeapStats_t st;
+
+	memset(r, 0, sizeof(*r));
+	live_n_ = 0;
+
+	for(uint32_t i = 0; i < events_n_; i++) {
+
+		const event_t * ev = &events_[i];
+		uint64_t t0;
+
+		if('a' == ev->op) {
+
+			void * p;
+
+			t0 = now_();
+			p = a->malloc(ev->size);
+			timing_add_(&r->malloc_t, now_() - t0);
+
+			if(NULL == p) {
+
+				r->failed++;
+				continue;
+			}
+
+			if(MAX_LIVE_ <= live_n_) {
+
+				fprintf(stderr, "%s: mas de %u bloques vivos\n", a->name, MAX_LIVE_);
+				exit(1);
+			}
+			live_id_[live_n_] = ev->id;
+			live_ptr_[live_n_++] = p;
+		} else {
+
+			int k = live_find_(ev->id);
+
+			if(0 > k) {
+
+				r->unknown_frees++;
+				continue;
+			}
+			t0 = now_();
+			a->free(live_ptr_[k]);
+			timing_add_(&r->free_t, now_() - t0);
+			live_n_--;
+			live_id_[k] = live_id_[live_n_];
+			live_ptr_[k] = live_ptr_[live_n_];
+		}
+
+		a->stats(&st);
+		if(frag_pct_(&st) > r->frag_max_pct)
+			r->frag_max_pct = frag_pct_(&st);
+	}
+
+	a->stats(&st);
+	r->min_free = st.xMinimumEverFreeBytesRemaining;
+	r->frag_end_pct = frag_pct_(&st);
+	r->largest_end = st.xSizeOfLargestFreeBlockInBytes;
+	r->free_blocks_end = st.xNumberOfFreeBlocks;
+}
+
+static void print_(const heap_replay_alloc_t * a, const result_t * r) {
+
+	printf("%-7s malloc %6u x %6.1f max %6llu | free %6u x %6.1f max %6llu | fallas %u"
+		   " | min libre %zu | frag fin %u%% max %u%% (%zu bloques, mayor %zu)\n",
+		   a->name, r->malloc_t.n, r->malloc_t.n ? (double)r->malloc_t.total / r->malloc_t.n : 0.0,
+		   (unsigned long long)r->malloc_t.max, r->free_t.n,
+		   r->free_t.n ? (double)r->free_t.total / r->free_t.n : 0.0, (unsigned long long)r->free_t.max,
+		   r->failed, r->min_free, r->frag_end_pct, r->frag_max_pct, r->free_blocks_end, r->largest_end);
+}
+
+/********************** external functions definition ************************/
+int main(int argc, char ** argv) {
+
+	const heap_replay_alloc_t * allocs[] = {&heap_replay_heap4, &heap_replay_tlsf};
+	uint32_t ops = 20000;
+	uint32_t seed = 1;
+	const char * path = NULL;
+	result_t r;
+
+	for(int i = 1; i < argc; i++) {
+
+		if(0 == strcmp(argv[i], "-n") && i + 1 < argc) {
+
+			ops = (uint32_t)strtoul(argv[++i], NULL, 0);
+		} else if(0 == strcmp(argv[i], "-s") && i + 1 < argc) {
+
+			seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+		} else if('-' != argv[i][0]) {
+
+			path = argv[i];
+		} else {
+
+			fprintf(stderr, "uso: %s [log.txt] [-n ops] [-s semilla]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if(NULL != path) {
+
+		if(!load_log_(path))
+			return 1;
+	} else {
+
+		synth_(ops, seed);
+	}
+
+	if(0 == events_n_) {
+
+		fprintf(stderr, "sin eventos\n");
+		return 1;
+	}
+	printf("%u eventos, heap de %u B\n", events_n_, (unsigned)configTOTAL_HEAP_SIZE);
+
+	for(uint32_t i = 0; i < sizeof(allocs) / sizeof(allocs[0]); i++) {
+
+		run_(allocs[i], &r);
+		print_(allocs[i], &r);
+
+		if(0 != r.unknown_frees)
+			printf("        %u frees de bloques anteriores a la captura (ignorados)\n", r.unknown_frees);
+	}
+	free(events_);
+	return 0;
+}
+
+/********************** end of file ******************************************/
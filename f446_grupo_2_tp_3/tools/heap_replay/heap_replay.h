@@ -0,0 +1,27 @@
+/*
+ * heap_replay.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+#ifndef HEAP_REPLAY_H_
+#define HEAP_REPLAY_H_
+
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+
+/* Un asignador del firmware compilado para la PC con sus funciones renombradas. */
+typedef struct {
+
+	const char * name;
+	void * (*malloc)(size_t size);
+	void (*free)(void * ptr);
+	void (*stats)(HeapStats_t * stats);
+} heap_replay_alloc_t;
+
+extern const heap_replay_alloc_t heap_replay_heap4;
+extern const heap_replay_alloc_t heap_replay_tlsf;
+
+#endif /* HEAP_REPLAY_H_ */
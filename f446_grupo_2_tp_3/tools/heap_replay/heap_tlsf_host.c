@@ -0,0 +1,23 @@
+/*
+ * heap_tlsf_host.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* heap_tlsf.c tal cual, con la API renombrada para convivir con heap_4.c. */
+#define configAPP_HEAP_TLSF                 1
+#define pvPortMalloc                        tlsf_malloc
+#define vPortFree                           tlsf_free
+#define vPortInitialiseBlocks               tlsf_initialise_blocks
+#define xPortGetFreeHeapSize                tlsf_free_size
+#define xPortGetMinimumEverFreeHeapSize     tlsf_min_ever_free
+#define vPortGetHeapStats                   tlsf_stats
+
+/* el centinela final solo escribe la cabecera, no el TlsfBlock_t completo */
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#include "../../Middlewares/Third_Party/FreeRTOS/Source/portable/MemMang/heap_tlsf.c"
+
+#include "heap_replay.h"
+
+const heap_replay_alloc_t heap_replay_tlsf = {"tlsf", tlsf_malloc, tlsf_free, tlsf_stats};
@@ -0,0 +1,18 @@
+/*
+ * task.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Sustituto de task.h para heap_replay: un solo hilo, sin secciones criticas. */
+#ifndef HEAP_REPLAY_TASK_H_
+#define HEAP_REPLAY_TASK_H_
+
+static inline void vTaskSuspendAll(void) {}
+static inline BaseType_t xTaskResumeAll(void) { return 0; }
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+#endif /* HEAP_REPLAY_TASK_H_ */
@@ -0,0 +1,321 @@
+/*
+ * log_store_host.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Pruebas de log_store.c en la PC sobre un modelo de la flash en RAM: las
+ * funciones log_store_hw_* de abajo reemplazan a log_store_hw.c. El modelo se
+ * comporta como la flash del micro: borrar deja todo en 0xFF, programar solo
+ * baja bits y falla si el byte no estaba borrado (cada byte se programa una vez
+ * por borrado, salvo una programacion toda en cero, como la que retira un
+ * encabezado de pagina), y se puede cortar la alimentacion a mitad de una
+ * escritura o hacer fallar una programacion sin reiniciar.
+ *
+ * Compilar y correr desde f446_grupo_2_tp_3:
+ *   gcc -O2 -Wall -Iapp/inc -o log_store_host tools/log_store_host.c \
+ *       app/src/log_store.c app/src/crc16.c && ./log_store_host
+ *
+ * Chequea, con 1, 2 y 3 sectores: orden y continuidad de lo recorrido, montaje
+ * en cada punto (la cabeza y el sector activo no cambian), rotacion sin perder
+ * el sector completo anterior, lectura por partes (log_store_read) que sigue en
+ * orden a traves de las rotaciones, desgaste parejo y cortes de alimentacion en
+ * el encabezado de pagina, en los datos y en el encabezado de un sector nuevo;
+ * tambien un encabezado de pagina que falla sin reinicio y deja la pagina
+ * borrada, con escrituras buenas despues. */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "log_store.h"
+
+/********************** macros and definitions *******************************/
+#define MODEL_MAX_SECTORS_      (4)
+#define MODEL_SECTOR_SIZE_      (4096u)		/* 16 paginas: rota seguido */
+#define PAGES_                  (MODEL_SECTOR_SIZE_ / LOG_STORE_PAGE_SIZE)
+#define MAX_RECORDS_            (4096)
+#define ROUNDS_                 (40 * PAGES_)
+
+#define CHECK_(cond)            check_((cond), #cond, __LINE__)
+
+typedef struct {
+
+	uint32_t prev;
+	uint32_t seen;
+	uint32_t first;
+	bool bad;
+} walk_t;
+
+/********************** internal data definition *****************************/
+static uint8_t flash_[MODEL_MAX_SECTORS_][MODEL_SECTOR_SIZE_];
+static uint32_t erases_[MODEL_MAX_SECTORS_];
+static uint8_t sectors_;
+static int32_t cut_after_ = -1;			/* bytes que se programan antes del corte */
+static bool glitch_;					/* el corte falla solo esa programacion */
+
+static bool written_[MAX_RECORDS_];		/* ids cuya escritura devolvio true */
+static uint32_t failures_;
+
+/********************** internal functions definition ************************/
+static void check_(bool ok, const char * what, int line) {
+
+	if(ok)
+		return;
+	failures_++;
+	printf("  FALLA linea %d: %s\n", line, what);
+}
+
+static void model_reset_(uint8_t sectors) {
+
+	memset(flash_, 0xFF, sizeof(flash_));
+	memset(erases_, 0, sizeof(erases_));
+	memset(written_, 0, sizeof(written_));
+	sectors_ = sectors;
+	cut_after_ = -1;
+	glitch_ = false;
+}
+
+/* Cada pagina lleva su id repetido hasta completar un largo que varia con el id. */
+static uint16_t fill_(uint8_t * buf, uint32_t id) {
+
+	uint16_t used = (uint16_t)(4 + (id * 36u) % (LOG_STORE_PAGE_DATA_SIZE - 3));
+
+	for(uint16_t i = 0; i < used; i++)
+		buf[i] = (uint8_t)(id >> (8 * (i % 4)));
+	return used;
+}
+
+static bool walk_cb_(const uint8_t * data, uint16_t used, void * ctx) {
+
+	walk_t * w = ctx;
+	uint8_t expect[LOG_STORE_PAGE_DATA_SIZE];
+	uint32_t id;
+
+	memcpy(&id, data, sizeof(id));
+
+	if(MAX_RECORDS_ <= id || !written_[id] || (0 != w->seen && id <= w->prev) ||
+	   used != fill_(expect, id) || 0 != memcmp(data, expect, used))
+		w->bad = true;
+
+	if(0 == w->seen)
+		w->first = id;
+	w->prev = id;
+	w->seen++;
+	return true;
+}
+
+/* Lo recorrido tiene que ser, en orden, todo lo escrito desde el primero visto. */
+static walk_t walk_(uint32_t next_id) {
+
+	walk_t w = {0};
+	walk_t r = {0};
+	log_store_cursor_t cur = {0, 0};
+	uint8_t data[LOG_STORE_PAGE_DATA_SIZE];
+	uint16_t used;
+	uint32_t expected = 0;
+
+	log_store_foreach(walk_cb_, &w);
+
+	/* lo mismo por partes, con log_store_read */
+	while(log_store_read(&cur, data, &used))
+		walk_cb_(data, used, &r);
+	CHECK_(r.seen == w.seen && r.first == w.first && r.prev == w.prev);
+
+	for(uint32_t id = w.first; 0 != w.seen && id < next_id; id++)
+		expected += written_[id] ? 1 : 0;
+
+	CHECK_(!w.bad);
+	CHECK_(expected == w.seen);
+	return w;
+}
+
+static bool write_(uint32_t id) {
+
+	uint8_t buf[LOG_STORE_PAGE_DATA_SIZE + 1];
+	uint16_t used = fill_(&buf[1], id);
+	bool ok;
+
+	/* desalineado a proposito: log_store_hw_program() recibe data sin alinear */
+	ok = log_store_write(&buf[1], used);
+	written_[id] = ok;
+	return ok;
+}
+
+static void remount_same_(void) {
+
+	log_store_info_t a;
+	log_store_info_t b;
+
+	log_store_get_info(&a);
+	CHECK_(log_store_mount());
+	log_store_get_info(&b);
+	CHECK_(a.active == b.active && a.seq == b.seq && a.head_page == b.head_page &&
+		   a.erase_count == b.erase_count);
+}
+
+static void run_(uint8_t sectors) {
+
+	uint32_t id = 0;
+	uint32_t torn = 0;
+	uint32_t emin = UINT32_MAX;
+	uint32_t emax = 0;
+	uint32_t roll_cut = UINT32_MAX;		/* ventana en la que ya se corto una rotacion */
+	uint32_t roll_cuts = 0;
+	log_store_cursor_t live = {0, 0};	/* lector lento: una pagina cada dos rondas */
+	walk_t lw = {0};
+	log_store_info_t info;
+
+	printf("%u sector(es) de %u paginas\n", sectors, PAGES_);
+	model_reset_(sectors);
+	CHECK_(log_store_mount());
+
+	for(uint32_t round = 0; round < ROUNDS_; round++) {
+
+		walk_t w;
+		bool fail = false;
+		uint8_t data[LOG_STORE_PAGE_DATA_SIZE];
+		uint16_t used;
+
+		log_store_get_info(&info);
+
+		/* cortes: en el encabezado de pagina, en los datos y, justo antes de
+		 * rotar, en el encabezado del sector nuevo */
+		if(37 == round % 61)
+			cut_after_ = 2;
+		else if(11 == round % 53)
+			cut_after_ = LOG_STORE_PAGE_HDR_SIZE + 8;
+		else if((0 == round % 23 || 0 == round % 29 || 0 == round % 31) &&
+				info.head_page < info.pages_per_sector)
+			fail = true;
+		else if(1 < sectors && info.head_page == info.pages_per_sector && 0 == (round / PAGES_) % 3 &&
+				roll_cut != round / PAGES_) {
+
+			cut_after_ = 6;
+			roll_cut = round / PAGES_;
+			roll_cuts++;
+		}
+
+		if(fail) {
+
+			/* falla del encabezado sin reinicio: con 23 falla toda la escritura
+			 * y la pagina queda borrada; con 29 solo esa programacion, antes
+			 * del primer byte; con 31 despues de medio word. Las escrituras que
+			 * siguen no pueden esconder lo que ya estaba grabado. */
+			cut_after_ = (0 == round % 31) ? 2 : 0;
+			glitch_ = (0 != round % 23);
+			CHECK_(!write_(id));
+			cut_after_ = -1;
+			glitch_ = false;
+			torn++;
+			id++;
+		} else if(0 <= cut_after_) {
+
+			CHECK_(!write_(id));
+			cut_after_ = -1;
+			torn++;
+			id++;
+			CHECK_(log_store_mount());	/* el reinicio despues del corte */
+		} else {
+
+			CHECK_(write_(id));
+			id++;
+		}
+
+		if(0 == round % 5)
+			remount_same_();
+
+		w = walk_(id);
+		CHECK_(0 == w.seen || w.prev + 1 == id || !written_[id - 1]);
+
+		/* el lector lento sigue en orden aunque le borren el sector al rotar */
+		if(0 == round % 2 && log_store_read(&live, data, &used)) {
+
+			walk_cb_(data, used, &lw);
+			CHECK_(!lw.bad);
+		}
+
+		/* pasada la primera rotacion queda siempre un sector completo de historia */
+		if(1 < sectors && PAGES_ * 2 < round)
+			CHECK_(PAGES_ - 1 <= w.seen + torn);
+	}
+
+	for(uint8_t s = 0; s < sectors; s++) {
+
+		emin = (erases_[s] < emin) ? erases_[s] : emin;
+		emax = (erases_[s] > emax) ? erases_[s] : emax;
+	}
+	log_store_get_info(&info);
+	printf("  %u paginas (%u cortadas), borrados %u..%u, sector activo %u seq %lu\n",
+		   id, torn, emin, emax, info.active, (unsigned long)info.seq);
+	CHECK_(emax - emin <= 1 + roll_cuts);	/* cada corte al rotar repite un borrado */
+}
+
+/********************** model of the flash (log_store_hw_*) ******************/
+uint8_t log_store_hw_sectors(void) {
+
+	return sectors_;
+}
+
+const uint8_t * log_store_hw_base(uint8_t sector) {
+
+	return flash_[sector];
+}
+
+uint32_t log_store_hw_size(uint8_t sector) {
+
+	(void)sector;
+	return MODEL_SECTOR_SIZE_;
+}
+
+bool log_store_hw_erase(uint8_t sector) {
+
+	CHECK_(sector < sectors_);
+	memset(flash_[sector], 0xFF, MODEL_SECTOR_SIZE_);
+	erases_[sector]++;
+	return true;
+}
+
+bool log_store_hw_program(uint8_t sector, uint32_t offset, const uint8_t * data, uint32_t len) {
+
+	bool zeros = true;
+
+	CHECK_(sector < sectors_);
+	CHECK_(0 == offset % 4 && 0 == len % 4 && offset + len <= MODEL_SECTOR_SIZE_);
+
+	for(uint32_t i = 0; i < len; i++)
+		zeros = zeros && (0 == data[i]);
+
+	for(uint32_t i = 0; i < len; i++) {
+
+		uint8_t * b = &flash_[sector][offset + i];
+
+		if(0 == cut_after_) {
+
+			if(glitch_)
+				cut_after_ = -1;
+			return false;
+		}
+		if(0 < cut_after_)
+			cut_after_--;
+
+		CHECK_(0xFF == *b || zeros);	/* una sola programacion por borrado */
+		*b &= data[i];
+	}
+	return true;
+}
+
+/********************** external functions definition ************************/
+int main(void) {
+
+	for(uint8_t s = 1; s <= 3; s++)
+		run_(s);
+
+	printf("%s (%u fallas)\n", (0 == failures_) ? "OK" : "ERROR", failures_);
+	return (0 == failures_) ? 0 : 1;
+}
+
+/********************** end of file ******************************************/
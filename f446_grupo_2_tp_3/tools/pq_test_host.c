@@ -0,0 +1,102 @@
+/*
+ * pq_test_host.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Corrida larga en la PC de la autoprueba de la cola de prioridad
+ * (priority_queue_test.c) contra el mismo priority_queue.c del firmware, sobre
+ * el sustituto del RTOS de tools/rtos_host. En el micro la autoprueba hace
+ * PRIO_QUEUE_TEST_EPISODES episodios al arrancar; aca se hacen millones de
+ * operaciones por cada largo de cola posible (PARAM_PQ_MAX_LEN de 2 a
+ * PRIO_QUEUE_MAX_LENGTH), cada uno en un proceso aparte porque la cola solo se
+ * inicializa una vez.
+ *
+ * Compilar y correr desde f446_grupo_2_tp_3 (agregar -DPRIO_QUEUE_CONFIG_NOTIFY=1
+ * para la variante con notificaciones):
+ *   gcc -O2 -Wall -pthread -DPRIO_QUEUE_CONFIG_SELFTEST=1 -Itools/rtos_host -Iapp/inc \
+ *       -o pq_test_host tools/pq_test_host.c tools/rtos_host/rtos_host.c \
+ *       app/src/priority_queue.c app/src/priority_queue_test.c && ./pq_test_host
+ *
+ *   ./pq_test_host [episodios] [semilla]
+ *
+ * Una falla sale con la secuencia minima que la reproduce, como en el micro. */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "cmsis_os.h"
+#include "rtos_host.h"
+#include "priority_queue.h"
+#include "priority_queue_test.h"
+
+/********************** macros and definitions *******************************/
+#define EPISODES_DEFAULT_       (100000u)	/* x PRIO_QUEUE_TEST_SEQ_LEN operaciones */
+
+#if 1 != PRIO_QUEUE_CONFIG_SELFTEST
+#error "compilar con -DPRIO_QUEUE_CONFIG_SELFTEST=1"
+#endif
+
+/********************** internal functions definition ************************/
+static bool run_limit_(uint16_t limit, uint32_t seed, uint32_t episodes) {
+
+	pid_t pid;
+	int status;
+
+	fflush(stdout);
+	pid = fork();
+
+	if(0 > pid) {
+
+		perror("fork");
+		return false;
+	}
+
+	if(0 == pid) {
+
+		rtos_host_params[PARAM_PQ_MAX_LEN] = limit;
+
+		bool ok = prio_queue_init() && limit == prio_queue_limit() && prio_queue_selftest(seed, episodes);
+
+		fflush(stdout);
+		_exit(ok ? 0 : 1);
+	}
+
+	if(0 > waitpid(pid, &status, 0))
+		return false;
+	return WIFEXITED(status) && 0 == WEXITSTATUS(status);
+}
+
+/********************** external functions definition ************************/
+int main(int argc, char * argv[]) {
+
+	uint32_t episodes = (1 < argc) ? (uint32_t)strtoul(argv[1], NULL, 0) : EPISODES_DEFAULT_;
+	uint32_t seed = (2 < argc) ? (uint32_t)strtoul(argv[2], NULL, 0) : PRIO_QUEUE_TEST_SEED;
+	uint32_t failures = 0;
+
+	printf("%lu episodios de %u operaciones por largo, semilla %lx, notify %u\n", (unsigned long)episodes,
+		   PRIO_QUEUE_TEST_SEQ_LEN, (unsigned long)seed, PRIO_QUEUE_CONFIG_NOTIFY);
+
+	for(uint16_t limit = 2; limit <= PRIO_QUEUE_MAX_LENGTH; limit++) {
+
+		printf("largo %u\n", limit);
+
+		/* otra semilla por largo: no se repiten las mismas secuencias */
+		if(!run_limit_(limit, seed + limit, episodes)) {
+
+			printf("  FALLA largo %u\n", limit);
+			failures++;
+		}
+	}
+
+	printf("%s (%lu fallas)\n", (0 == failures) ? "OK" : "ERROR", (unsigned long)failures);
+	return (0 == failures) ? 0 : 1;
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,322 @@
+/*
+ * queue_stress_host.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Prueba de concurrencia de las colas en la PC: el mismo priority_queue.c y
+ * work_queue.c del firmware, sobre el sustituto del RTOS de tools/rtos_host,
+ * con hilos de verdad en paralelo (en el micro la concurrencia es solo por
+ * desalojo). Es la version en la PC de stress_test.c: por ronda, n hilos
+ * productores llenan las dos colas; un consumidor vacia la cola de prioridad y
+ * WORKERS_ trabajadores corren work_worker_run(). Se verifica que no haya
+ * perdidos ni duplicados, que se respete el orden FIFO por productor y
+ * prioridad, y se informan las ops/s segun la cantidad de productores.
+ *
+ * Compilar y correr desde f446_grupo_2_tp_3, con ThreadSanitizer (agregar
+ * -DPRIO_QUEUE_CONFIG_NOTIFY=1 para la variante con notificaciones; sin
+ * -fsanitize=thread y con -O2 para medir):
+ *   gcc -O1 -g -Wall -pthread -fsanitize=thread -Itools/rtos_host -Iapp/inc \
+ *       -o queue_stress_host tools/queue_stress_host.c tools/rtos_host/rtos_host.c \
+ *       app/src/priority_queue.c app/src/work_queue.c && ./queue_stress_host
+ *
+ *   ./queue_stress_host [items por productor] [maximo de productores]
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cmsis_os.h"
+#include "rtos_host.h"
+#include "priority_queue.h"
+#include "work_queue.h"
+
+/********************** macros and definitions *******************************/
+#define ITEMS_DEFAULT_          (20000u)	/* por productor y ronda */
+#define PRODUCERS_DEFAULT_      (8u)
+#define WORKERS_                (2)			/* Task1 y Task2 */
+#define SENTINEL_               (UINT32_MAX)
+#define DRAIN_TIMEOUT_MS_       (5000)
+
+typedef struct {
+
+	pthread_t thread;
+	uint8_t id;
+	uint32_t inserted;
+	uint32_t rejected;			/* prio_queue_insert sin nodo libre */
+	uint32_t submitted;
+	uint32_t from_isr;			/* de submitted, por work_submit_from_isr */
+	uint32_t retries;			/* work_submit con la cola llena */
+} producer_t;
+
+/********************** internal data definition *****************************/
+static uint32_t items_;
+static uint32_t ids_;
+static producer_t * producer_;
+
+/* escritos solo por el consumidor; main los lee despues de ver rounds_done_ */
+static uint32_t * prio_seen_;
+static uint32_t (* next_seq_)[PRIO_QUEUE_PRIORITY_HIGH + 1];
+static uint32_t received_;
+static uint32_t prio_dups_;
+static uint32_t order_errors_;
+static uint32_t rounds_done_;
+static uint32_t consumer_ready_;
+
+/* escritos por los trabajadores, en seccion critica */
+static uint32_t * work_seen_;
+static uint32_t work_dups_;
+static uint32_t executed_;
+
+/********************** internal functions definition ************************/
+static bool test_and_set_(uint32_t * bitmap, uint32_t id) {
+
+	uint32_t mask = 1u << (id % 32);
+	bool was = (0 != (bitmap[id / 32] & mask));
+
+	bitmap[id / 32] |= mask;
+	return was;
+}
+
+static uint64_t now_ns_(void) {
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void job_(void * arg) {
+
+	uint32_t id = (uint32_t)(uintptr_t)arg;
+
+	taskENTER_CRITICAL();
+
+	if(ids_ <= id || test_and_set_(work_seen_, id))
+		work_dups_++;
+	taskEXIT_CRITICAL();
+	__atomic_fetch_add(&executed_, 1, __ATOMIC_RELEASE);
+}
+
+static void * worker_(void * arg) {
+
+	(void)arg;
+	work_worker_run();
+	return NULL;
+}
+
+/* Mismo productor y prioridad: FIFO. El desalojo solo puede dejar huecos. El
+ * centinela lo encola main al final de cada ronda y cierra la ronda. */
+static void * consumer_(void * arg) {
+
+	data_queue_t data;
+	prio_queue_priority_t prio;
+
+	(void)arg;
+	prio_queue_register_consumer(xTaskGetCurrentTaskHandle());
+	__atomic_store_n(&consumer_ready_, 1, __ATOMIC_RELEASE);
+
+	while(true) {
+
+		if(!prio_queue_extract(&data, &prio, portMAX_DELAY))
+			continue;
+
+		uint32_t id = data.hold_ms;
+
+		if(SENTINEL_ == id) {
+
+			__atomic_fetch_add(&rounds_done_, 1, __ATOMIC_RELEASE);
+			continue;
+		}
+		received_++;
+
+		if(ids_ <= id || test_and_set_(prio_seen_, id)) {
+
+			prio_dups_++;
+			continue;
+		}
+		uint32_t p = id / items_;
+		uint32_t seq = id % items_;
+
+		if(prio != (prio_queue_priority_t)(seq % 3) || seq < next_seq_[p][prio])
+			order_errors_++;
+		next_seq_[p][prio] = seq + 1;
+	}
+	return NULL;
+}
+
+static void * producer_fn_(void * arg) {
+
+	producer_t * st = arg;
+
+	for(uint32_t s = 0; s < items_; s++) {
+
+		uint32_t id = st->id * items_ + s;
+		data_queue_t data = {AO_LED_MESSAGE_ON, AO_LED_COLOR_RED, id};
+		work_prio_t wprio = (work_prio_t)(s % WORK_PRIO__N);
+
+		if(prio_queue_insert(data, (prio_queue_priority_t)(s % 3)))
+			st->inserted++;
+		else
+			st->rejected++;
+
+		/* uno de cada cuatro como si viniera de una interrupcion */
+		while(true) {
+
+			bool isr = (0 == s % 4);
+			BaseType_t woken;
+			bool ok = isr ? work_submit_from_isr(job_, (void *)(uintptr_t)id, wprio, &woken)
+						  : work_submit(job_, (void *)(uintptr_t)id, wprio);
+
+			if(ok) {
+
+				st->from_isr += isr ? 1 : 0;
+				break;
+			}
+			st->retries++;
+			taskYIELD();
+		}
+		st->submitted++;
+	}
+	return NULL;
+}
+
+/* Ronda con n productores; el consumidor y los trabajadores quedan bloqueados
+ * entre rondas, asi que el estado se puede reiniciar sin lock. */
+static bool round_(uint8_t n) {
+
+	producer_t sum = {0};
+	data_queue_t sentinel = {AO_LED_MESSAGE_ON, AO_LED_COLOR_RED, SENTINEL_};
+	uint32_t evicted0 = prio_queue_evicted();
+	uint32_t done0 = __atomic_load_n(&rounds_done_, __ATOMIC_ACQUIRE);
+	uint32_t evicted;
+	uint32_t executed;
+	uint32_t work_dups;
+	uint64_t t0;
+	uint64_t ns;
+	uint64_t ops;
+	TickType_t start;
+
+	memset(producer_, 0, n * sizeof(producer_[0]));
+	memset(prio_seen_, 0, (ids_ + 31) / 32 * sizeof(uint32_t));
+	memset(next_seq_, 0, n * sizeof(next_seq_[0]));
+	received_ = prio_dups_ = order_errors_ = 0;
+
+	taskENTER_CRITICAL();
+	memset(work_seen_, 0, (ids_ + 31) / 32 * sizeof(uint32_t));
+	work_dups_ = 0;
+	taskEXIT_CRITICAL();
+	__atomic_store_n(&executed_, 0, __ATOMIC_RELAXED);
+
+	t0 = now_ns_();
+
+	for(uint8_t i = 0; i < n; i++) {
+
+		producer_[i].id = i;
+		pthread_create(&producer_[i].thread, NULL, producer_fn_, &producer_[i]);
+	}
+
+	for(uint8_t i = 0; i < n; i++) {
+
+		pthread_join(producer_[i].thread, NULL);
+		sum.inserted += producer_[i].inserted;
+		sum.rejected += producer_[i].rejected;
+		sum.submitted += producer_[i].submitted;
+		sum.from_isr += producer_[i].from_isr;
+		sum.retries += producer_[i].retries;
+	}
+
+	/* LOW al fondo: sale despues de todo lo que quedo en la cola */
+	while(!prio_queue_insert(sentinel, PRIO_QUEUE_PRIORITY_LOW))
+		taskYIELD();
+
+	start = xTaskGetTickCount();
+	while((done0 == __atomic_load_n(&rounds_done_, __ATOMIC_ACQUIRE) ||
+		   sum.submitted != __atomic_load_n(&executed_, __ATOMIC_ACQUIRE)) &&
+		  pdMS_TO_TICKS(DRAIN_TIMEOUT_MS_) > (xTaskGetTickCount() - start))
+		vTaskDelay(1);
+
+	ns = now_ns_() - t0;
+	evicted = prio_queue_evicted() - evicted0;
+	executed = __atomic_load_n(&executed_, __ATOMIC_ACQUIRE);
+	ops = (uint64_t)sum.inserted + received_ + sum.submitted + executed;
+
+	taskENTER_CRITICAL();
+	work_dups = work_dups_;
+	taskEXIT_CRITICAL();
+
+	printf("%u prod: %llu ops/s\n", n, (unsigned long long)((0 == ns) ? 0 : ops * 1000000000u / ns));
+	printf("  pq: %lu env %lu rec %lu desal %lu sin nodo, %lu dup, %lu fuera de orden\n",
+		   (unsigned long)sum.inserted, (unsigned long)received_, (unsigned long)evicted,
+		   (unsigned long)sum.rejected, (unsigned long)prio_dups_, (unsigned long)order_errors_);
+	printf("  work: %lu env (%lu isr) %lu ejec %lu dup, %lu reintentos con cola llena\n",
+		   (unsigned long)sum.submitted, (unsigned long)sum.from_isr, (unsigned long)executed,
+		   (unsigned long)work_dups, (unsigned long)sum.retries);
+
+	return done0 != __atomic_load_n(&rounds_done_, __ATOMIC_ACQUIRE) && sum.inserted == received_ + evicted &&
+		   0 == prio_dups_ && 0 == order_errors_ && sum.submitted == executed && 0 == work_dups;
+}
+
+/********************** external functions definition ************************/
+int main(int argc, char * argv[]) {
+
+	uint32_t producers;
+	uint32_t failures = 0;
+	pthread_t thread;
+
+	items_ = (1 < argc) ? (uint32_t)strtoul(argv[1], NULL, 0) : ITEMS_DEFAULT_;
+	producers = (2 < argc) ? (uint32_t)strtoul(argv[2], NULL, 0) : PRODUCERS_DEFAULT_;
+
+	if(0 == items_ || 0 == producers || 255 < producers || UINT32_MAX / 2 / producers < items_) {
+
+		printf("uso: %s [items por productor] [maximo de productores]\n", argv[0]);
+		return 2;
+	}
+	ids_ = producers * items_;
+	producer_ = calloc(producers, sizeof(producer_[0]));
+	next_seq_ = calloc(producers, sizeof(next_seq_[0]));
+	prio_seen_ = calloc((ids_ + 31) / 32, sizeof(uint32_t));
+	work_seen_ = calloc((ids_ + 31) / 32, sizeof(uint32_t));
+
+	if(NULL == producer_ || NULL == next_seq_ || NULL == prio_seen_ || NULL == work_seen_)
+		return 2;
+
+	if(!prio_queue_init() || !work_init()) {
+
+		printf("error al iniciar las colas\n");
+		return 2;
+	}
+
+	/* trabajadores y consumidor quedan vivos entre rondas */
+	for(uint8_t i = 0; i < WORKERS_; i++)
+		pthread_create(&thread, NULL, worker_, NULL);
+	pthread_create(&thread, NULL, consumer_, NULL);
+
+	while(0 == __atomic_load_n(&consumer_ready_, __ATOMIC_ACQUIRE))
+		vTaskDelay(1);
+
+	printf("%lu items por productor, %u trabajadores, cola de %u, notify %u\n", (unsigned long)items_, WORKERS_,
+		   prio_queue_limit(), PRIO_QUEUE_CONFIG_NOTIFY);
+
+	for(uint32_t n = 1; n <= producers; n *= 2) {
+
+		if(!round_((uint8_t)n)) {
+
+			printf("  FALLA con %lu productores\n", (unsigned long)n);
+			failures++;
+		}
+	}
+
+	printf("%s (%lu fallas)\n", (0 == failures) ? "OK" : "ERROR", (unsigned long)failures);
+	fflush(stdout);
+	/* los trabajadores y el consumidor no terminan: exit() los corta */
+	exit((0 == failures) ? 0 : 1);
+}
+
+/********************** end of file ******************************************/
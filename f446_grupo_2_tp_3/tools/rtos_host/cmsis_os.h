@@ -0,0 +1,88 @@
+/*
+ * cmsis_os.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Sustituto de cmsis_os.h/FreeRTOS para compilar modulos de app/src en la PC
+ * sobre pthreads (rtos_host.c). Solo las primitivas que usan los modulos
+ * probados: semaforos y mutex, notificaciones, demoras en ticks de 1 ms y
+ * secciones criticas. No hay prioridades: cada tarea es un hilo del sistema y
+ * taskENTER_CRITICAL toma un unico mutex global (en el micro enmascara
+ * interrupciones, que tambien excluye a todas las demas tareas). */
+#ifndef RTOS_HOST_CMSIS_OS_H_
+#define RTOS_HOST_CMSIS_OS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+#define pdFALSE                             ((BaseType_t)0)
+#define pdTRUE                              ((BaseType_t)1)
+#define pdPASS                              (pdTRUE)
+#define pdFAIL                              (pdFALSE)
+#define portMAX_DELAY                       ((TickType_t)0xFFFFFFFFu)
+#define portTICK_PERIOD_MS                  ((TickType_t)1)
+#define pdMS_TO_TICKS(ms)                   ((TickType_t)(ms))
+#define tskIDLE_PRIORITY                    ((UBaseType_t)0)
+#define configASSERT(x)                     assert(x)
+
+typedef struct rtos_host_sem_t {
+
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	UBaseType_t count;
+	UBaseType_t max;
+} StaticSemaphore_t;
+
+typedef struct rtos_host_task_t {
+
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	uint32_t notify;
+} StaticTask_t;
+
+typedef StaticSemaphore_t * SemaphoreHandle_t;
+typedef StaticTask_t * TaskHandle_t;
+
+typedef struct {
+
+	TickType_t entered;
+} TimeOut_t;
+
+/* semaforos: el mutex es un binario que arranca dado (sin herencia de prioridad) */
+SemaphoreHandle_t xSemaphoreCreateCountingStatic(UBaseType_t max, UBaseType_t initial, StaticSemaphore_t * buf);
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial);
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t * buf);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t timeout);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t * woken);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t sem);
+
+/* tareas */
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t timeout);
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
+void vTaskSetTimeOutState(TimeOut_t * timeout);
+BaseType_t xTaskCheckForTimeOut(TimeOut_t * timeout, TickType_t * remaining);
+void rtos_host_enter_critical(void);
+void rtos_host_exit_critical(void);
+
+#define taskENTER_CRITICAL()                rtos_host_enter_critical()
+#define taskEXIT_CRITICAL()                 rtos_host_exit_critical()
+#define taskYIELD()                         sched_yield()
+#define vTaskPrioritySet(task, prio)        ((void)(task), (void)(prio))
+
+#endif /* RTOS_HOST_CMSIS_OS_H_ */
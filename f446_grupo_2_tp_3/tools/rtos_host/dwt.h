@@ -0,0 +1,23 @@
+/*
+ * dwt.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Sustituto de dwt.h en la PC: el "ciclo" es un ns de CLOCK_MONOTONIC, con la
+ * misma vuelta de 32 bits que CYCCNT (SystemCoreClock vale 1e9). */
+#ifndef RTOS_HOST_DWT_H_
+#define RTOS_HOST_DWT_H_
+
+#include <stdint.h>
+
+uint32_t rtos_host_cycles(void);
+
+#define cycle_counter_init()
+#define cycle_counter_reset()
+#define cycle_counter_get()                 rtos_host_cycles()
+#define cycles_per_us                       (SystemCoreClock / 1000000)
+#define cycle_counter_time_us()             (rtos_host_cycles() / cycles_per_us)
+
+#endif /* RTOS_HOST_DWT_H_ */
@@ -0,0 +1,17 @@
+/*
+ * logger.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Sustituto de logger.h en la PC: el log va a stdout, sin seccion critica. */
+#ifndef RTOS_HOST_LOGGER_H_
+#define RTOS_HOST_LOGGER_H_
+
+#include <stdio.h>
+
+#define LOGGER_LOG(...)                     printf(__VA_ARGS__)
+#define LOGGER_INFO(...)                    (printf("[info] "), printf(__VA_ARGS__), printf("\n"))
+
+#endif /* RTOS_HOST_LOGGER_H_ */
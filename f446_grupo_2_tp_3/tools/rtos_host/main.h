@@ -0,0 +1,17 @@
+/*
+ * main.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Sustituto de main.h en la PC: sin HAL. El "reloj" del contador de ciclos
+ * (dwt.h) es el de CLOCK_MONOTONIC en ns. */
+#ifndef RTOS_HOST_MAIN_H_
+#define RTOS_HOST_MAIN_H_
+
+#include <stdint.h>
+
+extern uint32_t SystemCoreClock;
+
+#endif /* RTOS_HOST_MAIN_H_ */
@@ -0,0 +1,268 @@
+/*
+ * rtos_host.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Primitivas de cmsis_os.h sobre pthreads, y lo minimo de app.c/params.c que
+ * piden los modulos probados en la PC. Un tick es 1 ms de CLOCK_MONOTONIC. */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "dwt.h"
+#include "app.h"
+#include "rtos_host.h"
+
+/********************** internal data definition *****************************/
+static pthread_once_t once_ = PTHREAD_ONCE_INIT;
+static pthread_mutex_t critical_;
+static __thread StaticTask_t self_;
+static __thread bool self_ready_;
+
+/********************** external data definition *****************************/
+uint32_t SystemCoreClock = 1000000000u;
+uint32_t rtos_host_params[PARAM__N];
+
+/********************** internal functions definition ************************/
+static void init_once_(void) {
+
+	pthread_mutexattr_t attr;
+
+	/* anidable, como uxCriticalNesting */
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&critical_, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+static uint64_t now_ns_(void) {
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void wait_init_(pthread_mutex_t * lock, pthread_cond_t * cond) {
+
+	pthread_condattr_t attr;
+
+	pthread_mutex_init(lock, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(cond, &attr);
+	pthread_condattr_destroy(&attr);
+}
+
+/* Espera en cond con el lock tomado hasta que ready() o se venza timeout (ticks). */
+static bool wait_(pthread_mutex_t * lock, pthread_cond_t * cond, TickType_t timeout,
+				  bool (*ready)(const void *), const void * obj) {
+
+	struct timespec until;
+	uint64_t deadline = now_ns_() + (uint64_t)timeout * 1000000u;
+
+	until.tv_sec = (time_t)(deadline / 1000000000u);
+	until.tv_nsec = (long)(deadline % 1000000000u);
+
+	while(!ready(obj)) {
+
+		if(0 == timeout)
+			return false;
+
+		if(portMAX_DELAY == timeout)
+			pthread_cond_wait(cond, lock);
+		else if(0 != pthread_cond_timedwait(cond, lock, &until))
+			return ready(obj);
+	}
+	return true;
+}
+
+static bool sem_ready_(const void * obj) {
+
+	return 0 < ((const StaticSemaphore_t *)obj)->count;
+}
+
+static bool notify_ready_(const void * obj) {
+
+	return 0 < ((const StaticTask_t *)obj)->notify;
+}
+
+/********************** external functions definition ************************/
+SemaphoreHandle_t xSemaphoreCreateCountingStatic(UBaseType_t max, UBaseType_t initial, StaticSemaphore_t * buf) {
+
+	wait_init_(&buf->lock, &buf->cond);
+	buf->count = initial;
+	buf->max = max;
+	return buf;
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial) {
+
+	StaticSemaphore_t * buf = malloc(sizeof(*buf));
+
+	return (NULL == buf) ? NULL : xSemaphoreCreateCountingStatic(max, initial, buf);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t * buf) {
+
+	return xSemaphoreCreateCountingStatic(1, 1, buf);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+
+	return xSemaphoreCreateCounting(1, 1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t timeout) {
+
+	bool ok;
+
+	pthread_mutex_lock(&sem->lock);
+	ok = wait_(&sem->lock, &sem->cond, timeout, sem_ready_, sem);
+
+	if(ok)
+		sem->count--;
+	pthread_mutex_unlock(&sem->lock);
+	return ok ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+
+	BaseType_t ret = pdFALSE;
+
+	pthread_mutex_lock(&sem->lock);
+
+	if(sem->count < sem->max) {
+
+		sem->count++;
+		pthread_cond_signal(&sem->cond);
+		ret = pdTRUE;
+	}
+	pthread_mutex_unlock(&sem->lock);
+	return ret;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t * woken) {
+
+	if(NULL != woken)
+		*woken = pdFALSE;
+	return xSemaphoreGive(sem);
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t sem) {
+
+	UBaseType_t count;
+
+	pthread_mutex_lock(&sem->lock);
+	count = sem->count;
+	pthread_mutex_unlock(&sem->lock);
+	return count;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+
+	if(!self_ready_) {
+
+		wait_init_(&self_.lock, &self_.cond);
+		self_.notify = 0;
+		self_ready_ = true;
+	}
+	return &self_;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+
+	pthread_mutex_lock(&task->lock);
+	task->notify++;
+	pthread_cond_signal(&task->cond);
+	pthread_mutex_unlock(&task->lock);
+	return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t timeout) {
+
+	TaskHandle_t self = xTaskGetCurrentTaskHandle();
+	uint32_t value;
+
+	pthread_mutex_lock(&self->lock);
+	wait_(&self->lock, &self->cond, timeout, notify_ready_, self);
+	value = self->notify;
+
+	if(0 < value)
+		self->notify = (pdTRUE == clear) ? 0 : value - 1;
+	pthread_mutex_unlock(&self->lock);
+	return value;
+}
+
+TickType_t xTaskGetTickCount(void) {
+
+	return (TickType_t)(now_ns_() / 1000000u);
+}
+
+void vTaskDelay(TickType_t ticks) {
+
+	struct timespec ts = {(time_t)(ticks / 1000u), (long)(ticks % 1000u) * 1000000L};
+
+	nanosleep(&ts, NULL);
+}
+
+void vTaskSetTimeOutState(TimeOut_t * timeout) {
+
+	timeout->entered = xTaskGetTickCount();
+}
+
+BaseType_t xTaskCheckForTimeOut(TimeOut_t * timeout, TickType_t * remaining) {
+
+	TickType_t now = xTaskGetTickCount();
+	TickType_t elapsed = now - timeout->entered;
+
+	if(portMAX_DELAY == *remaining)
+		return pdFALSE;
+
+	if(*remaining <= elapsed) {
+
+		*remaining = 0;
+		return pdTRUE;
+	}
+	*remaining -= elapsed;
+	timeout->entered = now;
+	return pdFALSE;
+}
+
+void rtos_host_enter_critical(void) {
+
+	pthread_once(&once_, init_once_);
+	pthread_mutex_lock(&critical_);
+}
+
+void rtos_host_exit_critical(void) {
+
+	pthread_mutex_unlock(&critical_);
+}
+
+uint32_t rtos_host_cycles(void) {
+
+	return (uint32_t)now_ns_();
+}
+
+uint32_t param_get(param_id_t id) {
+
+	return rtos_host_params[id];
+}
+
+void app_static_report(const char * name, size_t bytes) {
+
+	(void)name;
+	(void)bytes;
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,21 @@
+/*
+ * rtos_host.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: grupo 2 RTOS II
+ */
+
+/* Lo que los programas de prueba en la PC ven del sustituto del RTOS, ademas
+ * de las primitivas de cmsis_os.h. */
+#ifndef RTOS_HOST_RTOS_HOST_H_
+#define RTOS_HOST_RTOS_HOST_H_
+
+#include <stdint.h>
+
+#include "cmsis_os.h"
+#include "params.h"
+
+/* Valores que devuelve param_get(); en 0 el modulo usa su propio defecto. */
+extern uint32_t rtos_host_params[PARAM__N];
+
+#endif /* RTOS_HOST_RTOS_HOST_H_ */
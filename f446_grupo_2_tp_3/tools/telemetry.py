@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""Decodificador de la telemetria binaria de USART2 (app/src/telemetry.c).
+
+Trama: 0x00, COBS(tipo, seq, payload, CRC16 LE), 0x00. Lo que no decodifica
+como trama con CRC valido se muestra como texto (la consola comparte el puerto).
+
+Uso:
+    telemetry.py --port /dev/ttyACM0 [--baud 115200] [--csv salida/]
+    telemetry.py --file captura.bin [--csv salida/]
+"""
+
+import argparse
+import csv
+import os
+import struct
+import sys
+
+SYS, TASKS, LATENCY, PARAMS = 1, 2, 3, 4
+NAME_LEN = 8
+STATES = ["run", "ready", "blocked", "susp", "deleted", "invalid"]
+
+SYS_FIELDS = ["tick", "cpu_1s_pm", "heap_free", "heap_min", "ui_depth", "pq_depth",
+              "pq_evicted", "ui_rej_pulse", "ui_rej_short", "ui_rej_long",
+              "work_dropped", "work_executed", "stack_alarms", "tx_bytes", "frames_failed",
+              "led_holds_done"]
+SYS_FMT = "<IHIIBBIIIIIIIIII"
+
+# orden de param_id_t (app/inc/params.h)
+PARAM_NAMES = ["btn_period", "btn_pulse", "btn_short", "btn_long", "ui_period",
+               "ui_queue", "pq_max", "led_hold"]
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse(raw):
+    """Devuelve (tipo, seq, dict) o None si la trama no es valida."""
+    if len(raw) < 4 or crc16(raw[:-2]) != struct.unpack_from("<H", raw, len(raw) - 2)[0]:
+        return None
+    kind, seq, body = raw[0], raw[1], raw[2:-2]
+    if kind == SYS and len(body) == struct.calcsize(SYS_FMT):
+        return kind, seq, dict(zip(SYS_FIELDS, struct.unpack(SYS_FMT, body)))
+    if kind == TASKS and body:
+        tasks = []
+        for k in range(body[0]):
+            off = 1 + k * (NAME_LEN + 6)
+            name = body[off:off + NAME_LEN].split(b"\0")[0].decode("ascii", "replace")
+            prio, state, cpu, free = struct.unpack_from("<BBHH", body, off + NAME_LEN)
+            tasks.append({"name": name, "prio": prio, "state": STATES[min(state, 5)],
+                          "cpu_pm": cpu, "stack_free_words": free})
+        return kind, seq, {"tasks": tasks}
+    if kind == LATENCY and len(body) >= 13:
+        hz, avg, mx, n = struct.unpack_from("<IIIB", body)
+        hist = list(struct.unpack_from("<%dI" % n, body, 13))
+        return kind, seq, {"core_hz": hz, "avg_cycles": avg, "max_cycles": mx, "hist": hist}
+    if kind == PARAMS and len(body) >= 5:
+        version, n = struct.unpack_from("<IB", body)
+        values = struct.unpack_from("<%dI" % n, body, 5)
+        names = PARAM_NAMES + ["p%d" % i for i in range(len(PARAM_NAMES), n)]
+        return kind, seq, {"version": version, "values": dict(zip(names, values))}
+    return None
+
+
+def frames(stream):
+    """Parte el flujo en tramas por 0x00; el texto entre tramas sale como str."""
+    buf = bytearray()
+    for chunk in stream:
+        buf += chunk
+        while b"\0" in buf:
+            part, _, rest = bytes(buf).partition(b"\0")
+            buf = bytearray(rest)
+            if not part:
+                continue
+            raw = cobs_decode(part)
+            msg = parse(raw) if raw else None
+            yield msg if msg else part.decode("ascii", "replace")
+
+
+def drain_rate(prev, d):
+    """Encendidos de LED cumplidos por segundo entre dos tramas SYS."""
+    if prev is None or d["tick"] <= prev["tick"]:
+        return "-"
+    return "%.2f/s" % ((d["led_holds_done"] - prev["led_holds_done"]) * 1000 / (d["tick"] - prev["tick"]))
+
+
+last_sys = None
+
+
+def show(msg):
+    global last_sys
+    if isinstance(msg, str):
+        sys.stdout.write(msg)
+        return
+    kind, seq, d = msg
+    if kind == SYS:
+        cpu = "-" if d["cpu_1s_pm"] == 0xFFFF else "%.1f%%" % (d["cpu_1s_pm"] / 10)
+        print("[%3u] t=%ums cpu=%s heap=%u/%u ui=%u pq=%u desal=%u rech=%u/%u/%u work_drop=%u led=%u (%s)" % (
+            seq, d["tick"], cpu, d["heap_free"], d["heap_min"], d["ui_depth"], d["pq_depth"],
+            d["pq_evicted"], d["ui_rej_pulse"], d["ui_rej_short"], d["ui_rej_long"], d["work_dropped"],
+            d["led_holds_done"], drain_rate(last_sys, d)))
+        last_sys = d
+    elif kind == TASKS:
+        for t in d["tasks"]:
+            print("      %-8s p%u %-7s cpu %5.1f%% libre %u pal" % (
+                t["name"], t["prio"], t["state"], t["cpu_pm"] / 10, t["stack_free_words"]))
+    elif kind == LATENCY:
+        us = 1e6 / d["core_hz"] if d["core_hz"] else 0
+        print("      latencia UI: media %.1f us, max %.1f us, hist %s" % (
+            d["avg_cycles"] * us, d["max_cycles"] * us, d["hist"]))
+    elif kind == PARAMS:
+        print("      parametros v%u: %s" % (d["version"], " ".join(
+            "%s=%u" % kv for kv in d["values"].items())))
+
+
+class CsvSink:
+    def __init__(self, path):
+        os.makedirs(path, exist_ok=True)
+        self.files = {}
+        self.path = path
+
+    def _writer(self, name, header):
+        if name not in self.files:
+            f = open(os.path.join(self.path, name + ".csv"), "w", newline="")
+            w = csv.writer(f)
+            w.writerow(header)
+            self.files[name] = (f, w)
+        return self.files[name][1]
+
+    def write(self, msg, tick):
+        kind, seq, d = msg
+        if kind == SYS:
+            self._writer("sys", ["seq"] + SYS_FIELDS).writerow([seq] + [d[k] for k in SYS_FIELDS])
+        elif kind == TASKS:
+            w = self._writer("tasks", ["tick", "name", "prio", "state", "cpu_pm", "stack_free_words"])
+            for t in d["tasks"]:
+                w.writerow([tick, t["name"], t["prio"], t["state"], t["cpu_pm"], t["stack_free_words"]])
+        elif kind == LATENCY:
+            w = self._writer("latency", ["tick", "core_hz", "avg_cycles", "max_cycles"] +
+                             ["b%d" % i for i in range(len(d["hist"]))])
+            w.writerow([tick, d["core_hz"], d["avg_cycles"], d["max_cycles"]] + d["hist"])
+        elif kind == PARAMS:
+            w = self._writer("params", ["tick", "version"] + list(d["values"]))
+            w.writerow([tick, d["version"]] + list(d["values"].values()))
+        for f, _ in self.files.values():
+            f.flush()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--port")
+    src.add_argument("--file")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--csv", help="directorio para sys.csv, tasks.csv, latency.csv y params.csv")
+    args = ap.parse_args()
+
+    if args.port:
+        import serial  # pyserial
+        port = serial.Serial(args.port, args.baud, timeout=0.2)
+        stream = iter(lambda: port.read(256), None)
+    else:
+        f = open(args.file, "rb")
+        stream = iter(lambda: f.read(4096), b"")
+
+    sink = CsvSink(args.csv) if args.csv else None
+    tick = 0
+    try:
+        for msg in frames(stream):
+            show(msg)
+            if sink and not isinstance(msg, str):
+                if msg[0] == SYS:
+                    tick = msg[2]["tick"]
+                sink.write(msg, tick)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
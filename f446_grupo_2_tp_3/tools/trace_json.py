@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Pasa el volcado de trace_rec (app/src/trace_rec.c) a Chrome trace JSON.
+
+El firmware escribe por el logger una linea por registro:
+    [TRACE] inicio <registros> <ciclos por us>
+    [TRACE] r <ciclos> <tid> <evento> <irq> <objeto>
+    [TRACE] tarea <tid> <nombre>
+    [TRACE] fin
+Se toma el ultimo volcado completo del log; el resto de las lineas se ignora.
+CYCCNT da la vuelta cada 2^32 ciclos: las marcas se acumulan por diferencia
+entre registros sucesivos.
+
+Uso:
+    trace_json.py log.txt [-o traza.json]
+    (abrir con chrome://tracing o ui.perfetto.dev)
+"""
+
+import argparse
+import json
+import sys
+
+TAG = "[TRACE] "
+TID_ISR = 0
+
+INSTANT_NAMES = {"send": "send", "recv": "recv", "block_send": "block send",
+                 "block_recv": "block recv", "wait_notify": "wait notify",
+                 "delay": "delay"}
+
+
+def last_dump(lines):
+    """Devuelve (ciclos por us, registros, tareas) del ultimo volcado completo."""
+    dump = None
+    current = None
+    for line in lines:
+        pos = line.find(TAG)
+        if pos < 0:
+            continue
+        words = line[pos + len(TAG):].split()
+        if not words:
+            continue
+        if words[0] == "inicio" and len(words) == 3:
+            current = {"cycles_us": int(words[2]), "records": [], "tasks": {}}
+        elif current is None:
+            continue
+        elif words[0] == "r" and len(words) == 6:
+            current["records"].append((int(words[1]), int(words[2]), words[3], int(words[4]), words[5]))
+        elif words[0] == "tarea" and len(words) >= 3:
+            current["tasks"][int(words[1])] = " ".join(words[2:])
+        elif words[0] == "fin":
+            dump = current
+            current = None
+    return dump
+
+
+def to_events(dump):
+    events = []
+    elapsed = 0
+    prev = None
+    cycles_us = max(dump["cycles_us"], 1)
+
+    for cycles, tid, ev, irq, obj in dump["records"]:
+        if prev is not None:
+            elapsed += (cycles - prev) & 0xFFFFFFFF
+        prev = cycles
+        base = {"pid": 0, "tid": tid, "ts": elapsed // cycles_us}
+
+        if ev in ("in", "out"):
+            events.append(dict(base, name="run", ph="B" if ev == "in" else "E"))
+        elif ev in ("isr_in", "isr_out"):
+            events.append(dict(base, name="IRQ %d" % irq, ph="B" if ev == "isr_in" else "E", tid=TID_ISR))
+        elif ev == "notify":
+            to = int(obj[1:]) if obj.startswith("t") and obj[1:].isdigit() else obj
+            events.append(dict(base, name="notify", ph="i", s="t", args={"to": to}))
+        else:
+            events.append(dict(base, name=INSTANT_NAMES.get(ev, ev), ph="i", s="t", args={"obj": obj}))
+
+    for tid, name in sorted(dump["tasks"].items()):
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": tid, "args": {"name": name}})
+    events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": TID_ISR, "args": {"name": "ISR"}})
+    return events
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("log", help="log con las lineas [TRACE] ('-' para stdin)")
+    ap.add_argument("-o", "--out", help="archivo JSON (por defecto stdout)")
+    args = ap.parse_args()
+
+    src = sys.stdin if args.log == "-" else open(args.log, errors="replace")
+    with src:
+        dump = last_dump(src)
+    if dump is None:
+        sys.exit("sin volcado completo de trace_rec en el log")
+
+    out = open(args.out, "w") if args.out else sys.stdout
+    with out:
+        json.dump({"traceEvents": to_events(dump)}, out, indent=0)
+        out.write("\n")
+    print("%d registros, %d tareas" % (len(dump["records"]), len(dump["tasks"])), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()